@@ -705,6 +705,16 @@
  */
 //#define ENDSTOP_NOISE_THRESHOLD 2
 
+/**
+ * Endstop Block Mask
+ *
+ * Only read the endstops that the current move can trigger, as
+ * determined by the planner from the axes and directions of each
+ * block. Saves time in the endstop update on machines with many
+ * endstops (e.g., multiple Z endstops and a probe).
+ */
+//#define ENDSTOP_BLOCK_MASK
+
 //=============================================================================
 //============================== Movement Settings ============================
 //=============================================================================
@@ -1045,6 +1045,53 @@
 
   #define SD_MENU_CONFIRM_START             // Confirm the selected SD file before printing
 
+  // Read the printing file a block at a time into a ring of 512-byte buffers.
+  // While the command queue is full the next block is fetched, so the reader
+  // rarely waits on the card with the queue running low.
+  //#define SD_READ_AHEAD
+  #if ENABLED(SD_READ_AHEAD)
+    #define SD_READ_AHEAD_BLOCKS 2          // Buffers in the ring, 512 bytes of SRAM each
+  #endif
+
+  // Map the cluster runs of a file when it's opened for printing, so that
+  // M26 and power-loss resume seek without walking the FAT. Files with more
+  // fragments than the map holds fall back to walking the FAT.
+  //#define SD_EXTENT_MAP
+  #if ENABLED(SD_EXTENT_MAP)
+    #define SD_EXTENT_MAP_SIZE 16           // Cluster runs to hold, 8 bytes of SRAM each
+  #endif
+
+  // Gather data written by M28, M928 and binary transfers into whole blocks
+  // and write them from idle(), several at a time, so a slow card doesn't
+  // stall the main loop. Data waits no longer than SD_WRITE_BEHIND_MS before
+  // it's written and the file size synced, and all of it is written on close.
+  //#define SD_WRITE_BEHIND
+  #if ENABLED(SD_WRITE_BEHIND)
+    #define SD_WRITE_BEHIND_BLOCKS 2        // Buffers to fill, 512 bytes of SRAM each
+    #define SD_WRITE_BEHIND_MS  1000        // Longest time to hold unwritten data
+  #endif
+
+  // Index the items of the working directory by the positions of their
+  // entries, in one pass when it's first listed. The menus, sorting, and
+  // item counts then read each item directly instead of rescanning the
+  // directory from the start. Items past the end of the index are found
+  // by scanning from the last one indexed.
+  //#define SD_DIR_INDEX
+  #if ENABLED(SD_DIR_INDEX)
+    #define SD_DIR_INDEX_SIZE 64            // Items to index, 2 bytes of SRAM each
+  #endif
+
+  // Let M26 seek to the start of a line (N) or of a layer (L), and report the
+  // line and layer of the current position. Layers are counted from 0 by their
+  // ";LAYER:" or ";LAYER_CHANGE" comments in file order, not by the number in
+  // the comment (so raft layers count). The file is read only as far as needed,
+  // and the layer starts passed are indexed so later seeks read from the nearest.
+  // With too many layers to hold, the index keeps every other one.
+  //#define SD_LINE_INDEX
+  #if ENABLED(SD_LINE_INDEX)
+    #define SD_LINE_INDEX_SIZE 32           // Layer starts to hold, 12 bytes of SRAM each
+  #endif
+
   //#define MENU_ADDAUTOSTART               // Add a menu option to run auto#.g files
 
   #define EVENT_GCODE_SD_STOP "G28XY"       // G-code to run on Stop Print (e.g., "G28XY" or "G27")
@@ -1078,6 +1125,16 @@
     // Without a POWER_LOSS_PIN the following option helps reduce wear on the SD card,
     // especially with "vase mode" printing. Set too high and vases cannot be continued.
     #define POWER_LOSS_MIN_Z_CHANGE 0.05 // (mm) Minimum Z change before saving power-loss data
+
+    // Keep the recovery file as a preallocated, contiguous journal. Each save
+    // writes one record, with a sequence number and CRC, to the next block in
+    // turn and makes no file system updates. Loading takes the newest record
+    // that checks out. Much cheaper than rewriting the file, so saving often
+    // costs little print time or card wear.
+    //#define POWER_LOSS_JOURNAL
+    #if ENABLED(POWER_LOSS_JOURNAL)
+      #define POWER_LOSS_JOURNAL_BLOCKS 16  // Blocks to spread the records over
+    #endif
   #endif
 
   /**
@@ -1197,6 +1254,22 @@
   // Add an optimized binary file transfer mode, initiated with 'M28 B1'
   //#define BINARY_FILE_TRANSFER
 
+  #if ENABLED(BINARY_FILE_TRANSFER)
+    //#define BINARY_MOTION_PACKETS   // Also accept compact binary G0-G3 moves in binary mode
+    //#define BINARY_GCODE_STREAM     // Also accept (compressed) G-code to run directly in binary mode
+    //#define BINARY_FILE_DOWNLOAD    // Also send (compressed) files from the card back to the host
+
+    // Give binary mode receive buffers of its own, so packets can be larger than
+    // MAX_CMD_SIZE, and let the host send several packets before the first is
+    // acknowledged. A packet that arrives corrupt is requested again by itself
+    // while those after it are held. The host learns both sizes from the SYNC reply.
+    //#define BINARY_STREAM_WINDOW
+    #if ENABLED(BINARY_STREAM_WINDOW)
+      #define BINARY_STREAM_WINDOW_PACKETS 4  // Packets in flight: 1, 2, 4, or 8. Each takes a buffer.
+      #define BINARY_STREAM_PACKET_SIZE  512  // (bytes) Largest packet payload. Best a multiple of 512.
+    #endif
+  #endif
+
   /**
    * Set this option to one of the following (or the board's defaults apply):
    *
@@ -1727,6 +1800,20 @@
 #define MAX_CMD_SIZE 96
 #define BUFSIZE 4
 
+// Queued commands are packed end-to-end, so short commands take less room.
+// Set the total size (in bytes) of queued command text to buffer more short
+// commands in the same RAM, then raise BUFSIZE to allow more commands.
+// Default: BUFSIZE * MAX_CMD_SIZE
+//#define COMMAND_BUFFER_SIZE 384
+
+// With SERIAL_PORT_2, limit how many queued commands each port may hold, so
+// a chatty port (display, Wi-Fi bridge) can't crowd out the print stream.
+// A port at its limit is not read until its commands run.
+//#define SERIAL_QUEUE_LIMITS { BUFSIZE, 1 }
+
+// Count lines, bytes, errors and peak queue use for each serial port. Report with M577.
+//#define SERIAL_PORT_STATS
+
 // Transmission to Host Buffer Size
 // To save 386 bytes of PROGMEM (and TX_BUFFER_SIZE+3 bytes of RAM) set to 0.
 // To buffer a simple "ok" you need 4 bytes.
@@ -1736,6 +1823,13 @@
 // :[0, 2, 4, 8, 16, 32, 64, 128, 256]
 #define TX_BUFFER_SIZE 0
 
+// Hand host output to the serial HAL in chunks of up to this many bytes
+// instead of one character at a time. HALs with a bulk or DMA transmit path
+// send each chunk in one go. Auto-reports (M155, M27 S) are deferred while
+// the TX buffer is congested instead of blocking the main loop, on HALs that
+// report free TX space (AVR, STM32, LINUX). Others always send them.
+//#define SERIAL_TX_BATCH 32
+
 // Host Receive Buffer Size
 // Without XON/XOFF flow control (see SERIAL_XON_XOFF below) 32 bytes should be enough.
 // To use flow control, set this buffer size to at least 1024 bytes.
@@ -1776,6 +1870,22 @@
 // Some clients will have this feature soon. This could make the NO_TIMEOUTS unnecessary.
 //#define ADVANCED_OK
 
+// Let hosts stream without waiting for an "ok" per line. Enabled by the host
+// with 'M576 S1', after which received bytes are acknowledged in batches
+// with "ok C<bytes>". The credit is a fixed window, returned as bytes are
+// taken from the RX buffer, so it must be smaller than RX_BUFFER_SIZE (which
+// holds one byte less than its size). Command queue space is not counted.
+//#define CREDIT_FLOW_CONTROL
+#if ENABLED(CREDIT_FLOW_CONTROL)
+  #define CREDIT_FLOW_WINDOW 96   // (bytes) Unacknowledged bytes a host may send
+#endif
+
+// After a bad line keep up to this many valid lines that follow it, instead of
+// discarding them and requesting resends for each. Resent copies are simply
+// acknowledged, so a noisy connection doesn't starve the planner.
+// Uses MAX_CMD_SIZE bytes of SRAM per line.
+//#define SERIAL_RESEND_WINDOW 4
+
 // Printrun may have trouble receiving long strings all at once.
 // This option inserts short delays between lines of serial output.
 #define SERIAL_OVERRUN_PROTECTION
@@ -2825,6 +2935,7 @@
 
 #if ENABLED(FASTER_GCODE_PARSER)
   //#define GCODE_QUOTED_STRINGS  // Support for quoted string parameters
+  //#define PREPARSE_GCODE        // Parse commands as they are queued, using ~40 bytes of SRAM per BUFSIZE
 #endif
 
 //#define GCODE_CASE_INSENSITIVE  // Accept G-code sent to the firmware in lowercase
@@ -2855,12 +2966,14 @@
  * G-code Macros
  *
  * Add G-codes M810-M819 to define and run G-code macros.
- * Macros are not saved to EEPROM.
+ * With PREPARSE_GCODE macros are parsed once, when they are set.
  */
 //#define GCODE_MACROS
 #if ENABLED(GCODE_MACROS)
   #define GCODE_MACROS_SLOTS       5  // Up to 10 may be used
   #define GCODE_MACROS_SLOT_SIZE  50  // Maximum length of a single macro
+  #define GCODE_MACROS_SLOT_COMMANDS 5  // Maximum commands in a macro (with PREPARSE_GCODE)
+  //#define GCODE_MACROS_IN_EEPROM    // Save macros with M500 (requires EEPROM_SETTINGS)
 #endif
 
 /**
@@ -3157,6 +3270,15 @@
 //
 //#define M100_FREE_MEMORY_WATCHER
 
+//
+// M578 Report the count, total and longest run time of each command code,
+// and how much of that was spent waiting on the planner.
+//
+//#define GCODE_PROFILER
+#if ENABLED(GCODE_PROFILER)
+  #define GCODE_PROFILER_SLOTS 24   // Command codes to track. Extras are lumped together.
+#endif
+
 //
 // M43 - display pin status, toggle pins, watch pins, watch endstops & toggle LED, test servo probe
 //
@@ -109,6 +109,8 @@ typedef int8_t pin_t;
   #endif
 #endif
 
+#define SERIAL_TX_FREE(S) (S).availableForWrite()
+
 #ifdef DGUS_SERIAL_PORT
   #if !WITHIN(DGUS_SERIAL_PORT, -1, 3)
     #error "DGUS_SERIAL_PORT must be from -1 to 3. Please update your configuration."
@@ -178,9 +180,8 @@ FORCE_INLINE void HAL_timer_start(const uint8_t timer_num, const uint32_t) {
 
       // Set the timer pre-scaler
       // Generally we use a divider of 8, resulting in a 2MHz timer
-      // frequency on a 16MHz MCU. If you are going to change this, be
-      // sure to regenerate speed_lookuptable.h with
-      // create_speed_lookuptable.py
+      // frequency on a 16MHz MCU. The speed lookup tables are derived
+      // from STEPPER_TIMER_RATE, so they follow any change made here.
       SET_CS(1, PRESCALER_8);  //  CS 2 = 1/8 prescaler
 
       // Init Stepper ISR to 122 Hz for quick starting
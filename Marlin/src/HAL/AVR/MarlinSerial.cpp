@@ -504,6 +504,14 @@
     }
   }
 
+  // Bytes that can be written without waiting. Unbuffered writes
+  // always wait for the UART, so there's nothing to gain by holding off.
+  template<typename Cfg>
+  uint8_t MarlinSerial<Cfg>::availableForWrite() {
+    if (Cfg::TX_SIZE == 0) return 0xFF;
+    return (tx_buffer.tail - tx_buffer.head - 1) & (Cfg::TX_SIZE - 1);
+  }
+
   template<typename Cfg>
   void MarlinSerial<Cfg>::flushTX() {
 
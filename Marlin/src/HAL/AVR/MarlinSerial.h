@@ -217,6 +217,7 @@
       static ring_buffer_pos_t available();
       static void write(const uint8_t c);
       static void flushTX();
+      static uint8_t availableForWrite();
       #ifdef DGUS_SERIAL_PORT
         static ring_buffer_pos_t get_tx_buffer_free();
       #endif
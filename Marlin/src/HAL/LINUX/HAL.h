@@ -64,6 +64,7 @@ uint8_t _getc();
 extern HalSerial usb_serial;
 #define MYSERIAL0 usb_serial
 #define NUM_SERIAL 1
+#define SERIAL_TX_FREE(S) (S).availableForWrite()
 
 #define ST7920_DELAY_1 DELAY_NS(600)
 #define ST7920_DELAY_2 DELAY_NS(750)
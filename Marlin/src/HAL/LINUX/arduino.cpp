@@ -31,6 +31,17 @@
 void cli() { } // Disable
 void sei() { } // Enable
 
+// Pin change interrupts, raised by Gpio when a pin value changes
+void attachInterrupt(uint32_t pin, void (*callback)(), uint32_t mode) {
+  if (!VALID_PIN(pin)) return;
+  Gpio::attachInterrupt(pin, callback, mode == RISING ? GpioEvent::RISE : mode == FALLING ? GpioEvent::FALL : GpioEvent::NOP);
+}
+
+void detachInterrupt(uint32_t pin) {
+  if (!VALID_PIN(pin)) return;
+  Gpio::detachInterrupt(pin);
+}
+
 // Time functions
 void _delay_ms(const int delay_ms) {
   delay(delay_ms);
@@ -40,6 +51,10 @@ uint32_t millis() {
   return (uint32_t)Clock::millis();
 }
 
+uint32_t micros() {
+  return (uint32_t)Clock::micros();
+}
+
 // This is required for some Arduino libraries we are using
 void delayMicroseconds(uint32_t us) {
   Clock::delayMicros(us);
@@ -60,11 +60,15 @@ public:
   virtual void update() = 0;
 };
 
+typedef void (*pin_isr_t)();
+
 struct pin_data {
   uint8_t dir;
   uint8_t mode;
   uint16_t value;
   Peripheral* cb;
+  pin_isr_t isr;
+  GpioEvent::Type isr_edge; // RISE, FALL, or NOP for any change
 };
 
 class Gpio {
@@ -90,6 +94,10 @@ public:
       pin_map[pin].cb->interrupt(evt);
     }
     if (Gpio::logger != nullptr) Gpio::logger->log(evt);
+    // Pin change interrupts run synchronously, in the context that changed the pin
+    if (pin_map[pin].isr != nullptr && (evt_type == GpioEvent::RISE || evt_type == GpioEvent::FALL)
+      && (pin_map[pin].isr_edge == GpioEvent::NOP || pin_map[pin].isr_edge == evt_type)
+    ) pin_map[pin].isr();
   }
 
   static uint16_t get(pin_type pin) {
@@ -132,6 +140,17 @@ public:
     pin_map[pin].cb = per;
   }
 
+  static void attachInterrupt(pin_type pin, pin_isr_t isr, GpioEvent::Type edge) {
+    if (!valid_pin(pin)) return;
+    pin_map[pin].isr_edge = edge;
+    pin_map[pin].isr = isr;
+  }
+
+  static void detachInterrupt(pin_type pin) {
+    if (!valid_pin(pin)) return;
+    pin_map[pin].isr = nullptr;
+  }
+
   static void attachLogger(IOLogger* logger) {
     Gpio::logger = logger;
   }
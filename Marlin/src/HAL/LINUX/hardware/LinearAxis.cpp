@@ -24,10 +24,11 @@
 
 #include <random>
 #include <stdio.h>
+#include <stdlib.h>
 #include "Clock.h"
 #include "LinearAxis.h"
 
-LinearAxis::LinearAxis(pin_type enable, pin_type dir, pin_type step, pin_type end_min, pin_type end_max) {
+LinearAxis::LinearAxis(pin_type enable, pin_type dir, pin_type step, pin_type end_min, pin_type end_max, int32_t travel) {
   enable_pin = enable;
   dir_pin = dir;
   step_pin = step;
@@ -35,9 +36,12 @@ LinearAxis::LinearAxis(pin_type enable, pin_type dir, pin_type step, pin_type en
   max_pin = end_max;
 
   min_position = 50;
-  max_position = (200*80) + min_position;
+  max_position = travel + min_position;
   position = rand() % ((max_position - 40) - min_position) + (min_position + 20);
   last_update = Clock::nanos();
+  #ifdef ENDSTOP_TRIP_LOGGING
+    trip_pending = false;
+  #endif
 
   Gpio::attachPeripheral(step_pin, this);
 
@@ -48,17 +52,45 @@ LinearAxis::~LinearAxis() {
 }
 
 void LinearAxis::update() {
-
+  #ifdef ENDSTOP_TRIP_LOGGING
+    if (trip_pending && Clock::nanos() - last_update > 100000000) report_trip();
+  #endif
 }
 
+#ifdef ENDSTOP_TRIP_LOGGING
+
+  // Print how far the axis went past the endstop, and for how long,
+  // to measure the endstop response (on stderr, away from the serial)
+  void LinearAxis::report_trip() {
+    if (!trip_pending.exchange(false)) return;  // Already reported by the other thread
+    fprintf(stderr, "axis(%d) endstop: stopped %d steps, %lu us after the trigger\n",
+      step_pin, abs(position - trip_position), (unsigned long)((last_update - trip_time) / 1000));
+  }
+
+#endif
+
 void LinearAxis::interrupt(GpioEvent ev) {
   if (ev.pin_id == step_pin && !Gpio::pin_map[enable_pin].value){
     if (ev.event == GpioEvent::RISE) {
+      const bool dir = Gpio::pin_map[dir_pin].value;
+      #ifdef ENDSTOP_TRIP_LOGGING
+        if (trip_pending && dir != trip_dir) report_trip();
+      #endif
       last_update = ev.timestamp;
-      position += -1 + 2 * Gpio::pin_map[dir_pin].value;
-      Gpio::pin_map[min_pin].value = (position < min_position);
-      //Gpio::pin_map[max_pin].value = (position > max_position);
-      //if (position < min_position) printf("axis(%d) endstop : pos: %d, mm: %f, min: %d\n", step_pin, position, position / 80.0, Gpio::pin_map[min_pin].value);
+      position += -1 + 2 * dir;
+      // Change the endstops on the exact step that reaches them, so
+      // pin change interrupts (and the IO log) see the true trigger time.
+      const bool min_hit = position < min_position, max_hit = position > max_position;
+      #ifdef ENDSTOP_TRIP_LOGGING
+        if ((min_hit && !Gpio::get(min_pin)) || (max_hit && !Gpio::get(max_pin))) {
+          trip_time = ev.timestamp;
+          trip_position = position;
+          trip_dir = dir;
+          trip_pending = true;
+        }
+      #endif
+      if (min_hit != Gpio::get(min_pin)) Gpio::set(min_pin, min_hit);
+      if (max_hit != Gpio::get(max_pin)) Gpio::set(max_pin, max_hit);
     }
   }
 }
@@ -21,12 +21,15 @@
  */
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include "Gpio.h"
 
+//#define ENDSTOP_TRIP_LOGGING // Report how far each axis runs past a triggered endstop (on stderr)
+
 class LinearAxis: public Peripheral {
 public:
-  LinearAxis(pin_type enable, pin_type dir, pin_type step, pin_type end_min, pin_type end_max);
+  LinearAxis(pin_type enable, pin_type dir, pin_type step, pin_type end_min, pin_type end_max, int32_t travel=200*80);
   virtual ~LinearAxis();
   void update();
   void interrupt(GpioEvent ev);
@@ -42,4 +45,13 @@ public:
   int32_t max_position;
   uint64_t last_update;
 
+  #ifdef ENDSTOP_TRIP_LOGGING
+    // The last endstop trigger, reported once the axis stops or turns back
+    void report_trip();
+    uint64_t trip_time;
+    int32_t trip_position;
+    bool trip_dir;
+    std::atomic<bool> trip_pending;         // Set by the step ISR, cleared by either thread
+  #endif
+
 };
@@ -65,6 +65,7 @@ typedef uint8_t byte;
 //Interrupts
 void cli(); // Disable
 void sei(); // Enable
+#define digitalPinToInterrupt(P) (P) // Every pin can raise a change interrupt
 void attachInterrupt(uint32_t pin, void (*callback)(), uint32_t mode);
 void detachInterrupt(uint32_t pin);
 extern "C" void GpioEnableInt(uint32_t port, uint32_t pin, uint32_t mode);
@@ -98,6 +99,7 @@ extern "C" {
 void _delay_ms(const int delay);
 void delayMicroseconds(unsigned long);
 uint32_t millis();
+uint32_t micros();
 
 //IO functions
 void pinMode(const pin_t, const uint8_t);
@@ -62,6 +62,21 @@ public:
     return true;
   }
 
+  // Bulk transfers, returning the number of elements actually moved
+  uint32_t write(const T *values, uint32_t count) volatile {
+    count = _MIN(count, free());
+    for (uint32_t i = 0; i < count; i++) buffer[mask(index_write + i)] = values[i];
+    index_write += count;
+    return count;
+  }
+
+  uint32_t read(T *values, uint32_t count) volatile {
+    count = _MIN(count, available());
+    for (uint32_t i = 0; i < count; i++) values[i] = buffer[mask(index_read + i)];
+    index_read += count;
+    return count;
+  }
+
 private:
   uint32_t mask(uint32_t val) volatile {
     return buffer_mask & val;
@@ -100,6 +115,13 @@ public:
     return transmit_buffer.write(c);
   }
 
+  size_t write(const uint8_t *buffer, size_t size) {
+    if (!host_connected) return 0;
+    for (size_t i = 0; i < size;)
+      i += transmit_buffer.write(buffer + i, size - i);
+    return size;
+  }
+
   operator bool() { return host_connected; }
 
   uint16_t available() {
@@ -123,15 +145,7 @@ public:
     va_start(vArgs, format);
     int length = vsnprintf((char *) buffer, 256, (char const *) format, vArgs);
     va_end(vArgs);
-    if (length > 0 && length < 256) {
-      if (host_connected) {
-        for (int i = 0; i < length;) {
-          if (transmit_buffer.write(buffer[i])) {
-            ++i;
-          }
-        }
-      }
-    }
+    if (length > 0 && length < 256) write((const uint8_t*)buffer, length);
   }
 
   #define DEC 10
@@ -38,10 +38,10 @@ extern void loop();
 
 // simple stdout / stdin implementation for fake serial port
 void write_serial_thread() {
+  uint8_t buffer[256];
   for (;;) {
-    for (std::size_t i = usb_serial.transmit_buffer.available(); i > 0; i--) {
-      fputc(usb_serial.transmit_buffer.read(), stdout);
-    }
+    while (const std::size_t len = usb_serial.transmit_buffer.read(buffer, sizeof(buffer)))
+      fwrite(buffer, 1, len, stdout);
     std::this_thread::yield();
   }
 }
@@ -60,9 +60,11 @@ void read_serial_thread() {
 void simulation_loop() {
   Heater hotend(HEATER_0_PIN, TEMP_0_PIN);
   Heater bed(HEATER_BED_PIN, TEMP_BED_PIN);
-  LinearAxis x_axis(X_ENABLE_PIN, X_DIR_PIN, X_STEP_PIN, X_MIN_PIN, X_MAX_PIN);
-  LinearAxis y_axis(Y_ENABLE_PIN, Y_DIR_PIN, Y_STEP_PIN, Y_MIN_PIN, Y_MAX_PIN);
-  LinearAxis z_axis(Z_ENABLE_PIN, Z_DIR_PIN, Z_STEP_PIN, Z_MIN_PIN, Z_MAX_PIN);
+  // Place the max endstops at the far end of each axis, in steps
+  constexpr float steps_per_mm[] = DEFAULT_AXIS_STEPS_PER_UNIT;
+  LinearAxis x_axis(X_ENABLE_PIN, X_DIR_PIN, X_STEP_PIN, X_MIN_PIN, X_MAX_PIN, (X_MAX_POS - (X_MIN_POS)) * steps_per_mm[X_AXIS]);
+  LinearAxis y_axis(Y_ENABLE_PIN, Y_DIR_PIN, Y_STEP_PIN, Y_MIN_PIN, Y_MAX_PIN, (Y_MAX_POS - (Y_MIN_POS)) * steps_per_mm[Y_AXIS]);
+  LinearAxis z_axis(Z_ENABLE_PIN, Z_DIR_PIN, Z_STEP_PIN, Z_MIN_PIN, Z_MAX_PIN, (Z_MAX_POS - (Z_MIN_POS)) * steps_per_mm[Z_AXIS]);
   LinearAxis extruder0(E0_ENABLE_PIN, E0_DIR_PIN, E0_STEP_PIN, P_NC, P_NC);
 
   //#define GPIO_LOGGING // Full GPIO and Positional Logging
@@ -90,6 +90,8 @@
   #define NUM_SERIAL 1
 #endif
 
+#define SERIAL_TX_FREE(S) (S).availableForWrite()
+
 #if HAS_DGUS_LCD
   #if DGUS_SERIAL_PORT == 0
     #error "DGUS_SERIAL_PORT cannot be 0. (Port 0 does not exist.) Please update your configuration."
@@ -58,6 +58,10 @@
     //#define strchr_P(s,c) strchr(s,c)
   #endif
 
+  #ifndef strncmp_P
+    #define strncmp_P strncmp
+  #endif
+
   #ifndef snprintf_P
     #define snprintf_P snprintf
   #endif
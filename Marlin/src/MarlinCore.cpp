@@ -466,7 +466,7 @@ inline void manage_inactivity(const bool ignore_stepper_queue=false) {
     runout.run();
   #endif
 
-  if (queue.length < BUFSIZE) queue.get_available_commands();
+  if (queue.has_space()) queue.get_available_commands();
 
   const millis_t ms = millis();
 
@@ -723,6 +723,10 @@ void idle(
     }
   #endif
 
+  #if ENABLED(SD_WRITE_BEHIND)
+    card.write_behind();
+  #endif
+
   #if ENABLED(USB_FLASH_DRIVE_SUPPORT)
     Sd2Card::idle();
   #endif
@@ -200,6 +200,9 @@
 #define STR_SD_ERR_WRITE_TO_FILE            "error writing to file"
 #define STR_SD_ERR_READ                     "SD read error"
 #define STR_SD_CANT_ENTER_SUBDIR            "Cannot enter subdir: "
+#define STR_SD_LINE_NOT_FOUND               "Not found in file"
+#define STR_SD_LINE                         "SD line "
+#define STR_SD_LAYER                        " layer "
 
 #define STR_ENDSTOPS_HIT                    "endstops hit: "
 #define STR_ERR_COLD_EXTRUDE_STOP           " cold extrusion prevented"
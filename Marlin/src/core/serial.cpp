@@ -32,9 +32,41 @@ static const char echomagic[]  PROGMEM = "echo:";
   int8_t serial_port_index = 0;
 #endif
 
-void serialprintPGM(PGM_P str) {
-  while (const char c = pgm_read_byte(str++)) SERIAL_CHAR(c);
-}
+#if SERIAL_TX_BATCH
+
+  // Stage PROGMEM text so the HAL gets a few bulk writes per message
+  void serialprintPGM(PGM_P str) {
+    uint8_t buf[SERIAL_TX_BATCH], n = 0;
+    while (const char c = pgm_read_byte(str++)) {
+      buf[n++] = c;
+      if (n == sizeof(buf)) { SERIAL_OUT(write, buf, n); n = 0; }
+    }
+    if (n) SERIAL_OUT(write, buf, n);
+  }
+
+  // True if every active port can take 'len' bytes without blocking.
+  // HALs that can't report TX space always say yes.
+  bool serial_tx_room(const uint8_t len) {
+    #ifdef SERIAL_TX_FREE
+      #if NUM_SERIAL > 1
+        if ((!serial_port_index || serial_port_index == SERIAL_BOTH) && SERIAL_TX_FREE(MYSERIAL0) < len) return false;
+        if (serial_port_index && SERIAL_TX_FREE(MYSERIAL1) < len) return false;
+      #else
+        if (SERIAL_TX_FREE(MYSERIAL0) < len) return false;
+      #endif
+    #else
+      UNUSED(len);
+    #endif
+    return true;
+  }
+
+#else
+
+  void serialprintPGM(PGM_P str) {
+    while (const char c = pgm_read_byte(str++)) SERIAL_CHAR(c);
+  }
+
+#endif
 void serial_echo_start()  { serialprintPGM(echomagic); }
 void serial_error_start() { serialprintPGM(errormagic); }
 
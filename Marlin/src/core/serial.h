@@ -283,6 +283,9 @@ inline void serial_echopair_PGM(PGM_P const s_P, bool v)    { serial_echopair_PG
 inline void serial_echopair_PGM(PGM_P const s_P, void *v)   { serial_echopair_PGM(s_P, (unsigned long)v); }
 
 void serialprintPGM(PGM_P str);
+#if SERIAL_TX_BATCH
+  bool serial_tx_room(const uint8_t len);
+#endif
 void serial_echo_start();
 void serial_error_start();
 void serial_ternary(const bool onoff, PGM_P const pre, PGM_P const on, PGM_P const off, PGM_P const post=nullptr);
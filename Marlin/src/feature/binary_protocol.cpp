@@ -33,4 +33,272 @@ bool SDFileTransferProtocol::transfer_active, SDFileTransferProtocol::dummy_tran
 
 BinaryStream binaryStream[NUM_SERIAL];
 
+#if ENABLED(BINARY_STREAM_COMPRESSION)
+  heatshrink_decoder hsd;
+#endif
+uint8_t decode_buffer[512]; // = { 0 }
+
+#if ENABLED(BINARY_STREAM_WINDOW)
+  char BinaryStream::packet_buffer[BINARY_STREAM_WINDOW_PACKETS][BINARY_STREAM_PACKET_SIZE];
+#endif
+
+#if ENABLED(BINARY_FILE_DOWNLOAD)
+
+  #if ENABLED(BINARY_STREAM_COMPRESSION)
+    static heatshrink_encoder hse;
+  #endif
+  static uint8_t read_buffer[32], read_index, read_count; // Read from the card, not yet encoded
+  static uint16_t block_size;                           // Last block sent, kept in decode_buffer
+
+  bool SDFileTransferProtocol::reading, SDFileTransferProtocol::read_done;
+
+  bool SDFileTransferProtocol::file_open_read(char* filename) {
+    if (card.isFileOpen()) return false;                // Don't disturb a print, even a paused one
+    if (!card.isMounted()) card.mount();
+    card.openFileRead(filename);
+    if (!card.isFileOpen()) return false;
+    transfer_active = reading = true;
+    dummy_transfer = read_done = false;
+    read_index = read_count = block_size = 0;
+    #if ENABLED(BINARY_STREAM_COMPRESSION)
+      heatshrink_encoder_reset(&hse);
+    #endif
+    return true;
+  }
+
+  /**
+   * Send the next block of the open file, heatshrink-compressed if asked:
+   *   PFT:data:<size>,<checksum>   then <size> bytes of data
+   * The checksum is the packet checksum over the data. A size of 0 ends the
+   * file. With 'repeat' send the last block again, to replace a corrupt one.
+   */
+  void SDFileTransferProtocol::file_read(const bool repeat) {
+    if (!repeat) {
+      block_size = 0;
+      #if ENABLED(BINARY_STREAM_COMPRESSION)
+        if (compression) {
+          for (;;) {
+            size_t count = 0;
+            heatshrink_encoder_poll(&hse, &decode_buffer[block_size], sizeof(decode_buffer) - block_size, &count);
+            block_size += count;
+            if (block_size == sizeof(decode_buffer)) break;     // Block full
+            if (read_index < read_count) {                      // Encode more input
+              heatshrink_encoder_sink(&hse, &read_buffer[read_index], read_count - read_index, &count);
+              read_index += count;
+            }
+            else if (read_done) {                               // Flush the rest
+              if (heatshrink_encoder_finish(&hse) == HSER_FINISH_DONE) break;
+            }
+            else {
+              const int16_t n = card.read(read_buffer, sizeof(read_buffer));
+              if (n < 0) { SERIAL_ECHOLNPGM("PFT:ioerror"); return; }
+              read_done = !n;
+              read_index = 0;
+              read_count = n;
+            }
+          }
+        }
+        else
+      #endif
+      {
+        const int16_t n = card.read(decode_buffer, sizeof(decode_buffer));
+        if (n < 0) { SERIAL_ECHOLNPGM("PFT:ioerror"); return; }
+        block_size = n;
+      }
+    }
+
+    uint16_t cs = 0;
+    for (uint16_t i = 0; i < block_size; i++) cs = BinaryStream::checksum(cs, decode_buffer[i]);
+    SERIAL_ECHOLNPAIR("PFT:data:", block_size, ",", cs);
+    for (uint16_t i = 0; i < block_size; i++) SERIAL_CHAR(decode_buffer[i]);
+  }
+
+#endif // BINARY_FILE_DOWNLOAD
+
+#if ENABLED(BINARY_MOTION_PACKETS)
+
+  #include "../MarlinCore.h"
+  #include "../module/motion.h"
+  #include "../module/planner.h"
+  #include "../gcode/queue.h"
+
+  uint8_t MotionProtocol::input[BINARY_STREAM_PACKET_SIZE];
+  uint16_t MotionProtocol::input_size, MotionProtocol::input_index;
+
+  #if ENABLED(ARC_SUPPORT) && DISABLED(SCARA)
+    void plan_arc(const xyze_pos_t &cart, const ab_float_t &offset, const uint8_t clockwise);
+  #endif
+
+  void MotionProtocol::move(const uint8_t code, const uint8_t fields, const int32_t (&value)[FIELD_J + 1]) {
+    if (!MOTION_CONDITIONS) return;
+
+    constexpr float scale = 1.0f / (SCALE);
+    destination = current_position;
+    LOOP_XYZ(i) if (TEST(fields, FIELD_X + i)) destination[i] = LOGICAL_TO_NATIVE(value[FIELD_X + i] * scale, i);
+    if (TEST(fields, FIELD_E)) destination.e = value[FIELD_E] * scale;
+    if (TEST(fields, FIELD_F) && value[FIELD_F] > 0) feedrate_mm_s = MMM_TO_MMS(value[FIELD_F] * scale);
+
+    #if ENABLED(ARC_SUPPORT) && DISABLED(SCARA)
+      if (code >= 2) {
+        ab_float_t arc_offset = { value[FIELD_I] * scale, value[FIELD_J] * scale };
+        if (arc_offset) plan_arc(destination, arc_offset, code == 2);
+        return;
+      }
+    #endif
+
+    #if IS_SCARA
+      if (code == 0) return prepare_fast_move_to_destination();
+    #else
+      UNUSED(code);
+    #endif
+    prepare_line_to_destination();
+  }
+
+  bool MotionProtocol::drain() {
+    while (input_index < input_size) {
+      if (queue.has_commands_queued() || planner.is_full()) return false; // Keep the order of queued commands
+
+      const uint8_t code = input[input_index], fields = input[input_index + 1];
+      uint16_t i = input_index + 2;
+      int32_t value[FIELD_J + 1] = { 0 };
+      bool valid = i <= input_size && code <= 3 && fields < _BV(FIELD_J + 1);
+      LOOP_LE_N(f, FIELD_J) if (valid && TEST(fields, f)) {
+        valid = i + sizeof(int32_t) <= input_size;
+        if (valid) memcpy(&value[f], &input[i], sizeof(int32_t));
+        i += sizeof(int32_t);
+      }
+      if (!valid) {                             // Drop the rest of the packet
+        SERIAL_ECHOLNPGM("PMP:invalid");
+        input_index = input_size;
+        break;
+      }
+      input_index = i;
+      move(code, fields, value);
+    }
+    return true;
+  }
+
+  void MotionProtocol::process(const uint8_t packet_type, char* buffer, const uint16_t length) {
+    switch (static_cast<MotionPacket>(packet_type)) {
+      case MotionPacket::QUERY:
+        SERIAL_ECHOLNPAIR("PMP:version:", VERSION_MAJOR, ".", VERSION_MINOR, ".", VERSION_PATCH, ":scale:", SCALE);
+        break;
+      case MotionPacket::MOVE:
+        if (length > sizeof(input)) { SERIAL_ECHOLNPGM("PMP:invalid"); break; }
+        memcpy(input, buffer, length);          // The packet buffer is reused by the next packet
+        input_size = length;
+        input_index = 0;
+        drain();
+        break;
+      default:
+        SERIAL_ECHOLNPGM("PMP:invalid");
+        break;
+    }
+  }
+
+#endif // BINARY_MOTION_PACKETS
+
+#if ENABLED(BINARY_GCODE_STREAM)
+
+  #include "../gcode/queue.h"
+
+  heatshrink_decoder GCodeStreamProtocol::hsd;
+  uint8_t GCodeStreamProtocol::input[BINARY_STREAM_PACKET_SIZE], GCodeStreamProtocol::output[32];
+  uint16_t GCodeStreamProtocol::input_size, GCodeStreamProtocol::input_index;
+  uint8_t GCodeStreamProtocol::output_size, GCodeStreamProtocol::output_index;
+  char GCodeStreamProtocol::line[MAX_CMD_SIZE];
+  uint8_t GCodeStreamProtocol::line_size;
+  bool GCodeStreamProtocol::active, GCodeStreamProtocol::closing, GCodeStreamProtocol::compression,
+       GCodeStreamProtocol::line_ready, GCodeStreamProtocol::in_comment;
+
+  // Add a character to the line, leaving out comments and leading spaces
+  void GCodeStreamProtocol::add_char(const char c) {
+    if (c == '\n' || c == '\r') {
+      line[line_size] = '\0';
+      line_ready = line_size > 0;
+      line_size = 0;
+      in_comment = false;
+    }
+    else if (in_comment || c == ';' || (c == ' ' && !line_size))
+      in_comment |= (c == ';');
+    else if (line_size < MAX_CMD_SIZE - 1)
+      line[line_size++] = c;
+  }
+
+  // Get the next character of G-code, decoding more as needed
+  bool GCodeStreamProtocol::next_char(uint8_t &c) {
+    if (!compression) {
+      if (input_index >= input_size) return false;
+      c = input[input_index++];
+      return true;
+    }
+    if (output_index >= output_size) {
+      size_t count;
+      if (input_index < input_size) {
+        heatshrink_decoder_sink(&hsd, &input[input_index], input_size - input_index, &count);
+        input_index += count;
+      }
+      heatshrink_decoder_poll(&hsd, output, sizeof(output), &count);
+      output_index = 0;
+      output_size = count;
+      if (!count) return false;
+    }
+    c = output[output_index++];
+    return true;
+  }
+
+  bool GCodeStreamProtocol::drain() {
+    for (;;) {
+      if (line_ready) {
+        if (!queue.enqueue_line(line, card.transfer_port_index)) return false;
+        line_ready = false;
+      }
+      uint8_t c;
+      if (next_char(c))
+        add_char(c);
+      else if (closing) {
+        add_char('\n');                         // End the last line, if unterminated
+        if (line_ready) continue;               // and queue it before replying
+        closing = active = false;
+        SERIAL_ECHOLNPGM("PGS:success");
+        return true;
+      }
+      else
+        return true;
+    }
+  }
+
+  void GCodeStreamProtocol::process(const uint8_t packet_type, char* buffer, const uint16_t length) {
+    switch (static_cast<GCodeStream>(packet_type)) {
+      case GCodeStream::QUERY:
+        SERIAL_ECHOLNPAIR("PGS:version:", VERSION_MAJOR, ".", VERSION_MINOR, ".", VERSION_PATCH);
+        break;
+      case GCodeStream::OPEN:
+        active = true;
+        compression = length && (buffer[0] & 0x1);
+        input_size = input_index = output_size = output_index = line_size = 0;
+        line_ready = in_comment = closing = false;
+        heatshrink_decoder_reset(&hsd);
+        SERIAL_ECHOLNPGM("PGS:success");
+        break;
+      case GCodeStream::DATA:
+        if (!active || length > sizeof(input)) { SERIAL_ECHOLNPGM("PGS:invalid"); break; }
+        memcpy(input, buffer, length);          // The packet buffer is reused by the next packet
+        input_size = length;
+        input_index = 0;
+        drain();
+        break;
+      case GCodeStream::CLOSE:
+        if (!active) { SERIAL_ECHOLNPGM("PGS:invalid"); break; }
+        closing = true;                         // Reply once all lines are queued
+        drain();
+        break;
+      default:
+        SERIAL_ECHOLNPGM("PGS:invalid");
+        break;
+    }
+  }
+
+#endif // BINARY_GCODE_STREAM
+
 #endif // BINARY_FILE_TRANSFER
@@ -27,6 +27,9 @@
 
 #if ENABLED(BINARY_STREAM_COMPRESSION)
   #include "../libs/heatshrink/heatshrink_decoder.h"
+  #if ENABLED(BINARY_FILE_DOWNLOAD)
+    #include "../libs/heatshrink/heatshrink_encoder.h"
+  #endif
 #endif
 
 inline bool bs_serial_data_available(const uint8_t index) {
@@ -50,9 +53,9 @@ inline int bs_read_serial(const uint8_t index) {
 }
 
 #if ENABLED(BINARY_STREAM_COMPRESSION)
-  static heatshrink_decoder hsd;
-  static uint8_t decode_buffer[512] = {};
+  extern heatshrink_decoder hsd;
 #endif
+extern uint8_t decode_buffer[512];      // Data for the card, gathered into whole blocks
 
 class SDFileTransferProtocol  {
 private:
@@ -112,18 +115,48 @@ private:
         return true;
       }
     #endif
-    return (dummy_transfer || card.write(buffer, length) >= 0);
+    return (dummy_transfer || write_blocks(reinterpret_cast<uint8_t*>(buffer), length));
   }
 
-  static bool file_close() {
-    if (!dummy_transfer) {
-      #if ENABLED(BINARY_STREAM_COMPRESSION)
-        // flush any buffered data
-        if (data_waiting) {
+  // Write the packet to the card in whole blocks. Write runs of them straight
+  // from the packet and gather the rest in decode_buffer, so packets of any
+  // size always write the card a full, aligned block at a time.
+  static bool write_blocks(uint8_t *data, size_t length) {
+    while (length) {
+      size_t count;
+      if (!data_waiting && length >= sizeof(decode_buffer)) {
+        count = length - length % sizeof(decode_buffer);
+        if (card.write(data, count) < 0) return false;
+      }
+      else {
+        count = _MIN(length, sizeof(decode_buffer) - data_waiting);
+        memcpy(&decode_buffer[data_waiting], data, count);
+        data_waiting += count;
+        if (data_waiting == sizeof(decode_buffer)) {
           if (card.write(decode_buffer, data_waiting) < 0) return false;
           data_waiting = 0;
         }
-      #endif
+      }
+      data += count;
+      length -= count;
+    }
+    return true;
+  }
+
+  static bool file_close() {
+    #if ENABLED(BINARY_FILE_DOWNLOAD)
+      if (reading) {
+        card.closefile();
+        transfer_active = reading = false;
+        return true;
+      }
+    #endif
+    if (!dummy_transfer) {
+      // flush any buffered data
+      if (data_waiting) {
+        if (card.write(decode_buffer, data_waiting) < 0) return false;
+        data_waiting = 0;
+      }
       card.closefile();
       card.release();
     }
@@ -135,6 +168,12 @@ private:
   }
 
   static void transfer_abort() {
+    #if ENABLED(BINARY_FILE_DOWNLOAD)
+      if (reading) {                          // keep the file, it's only being read
+        file_close();
+        return;
+      }
+    #endif
     if (!dummy_transfer) {
       card.closefile();
       card.removeFile(card.filename);
@@ -147,10 +186,18 @@ private:
     return;
   }
 
-  enum class FileTransfer : uint8_t { QUERY, OPEN, CLOSE, WRITE, ABORT };
+  #if ENABLED(BINARY_FILE_DOWNLOAD)
+    static bool file_open_read(char* filename);
+    static void file_read(const bool repeat);
+  #endif
+
+  enum class FileTransfer : uint8_t { QUERY, OPEN, CLOSE, WRITE, ABORT, OPEN_READ, READ };
 
   static size_t data_waiting, transfer_timeout, idle_timeout;
   static bool transfer_active, dummy_transfer, compression;
+  #if ENABLED(BINARY_FILE_DOWNLOAD)
+    static bool reading, read_done;
+  #endif
 
 public:
 
@@ -200,7 +247,11 @@ public:
         else SERIAL_ECHOLNPGM("PFT:invalid");
         break;
       case FileTransfer::WRITE:
-        if (!transfer_active)
+        if (!transfer_active
+          #if ENABLED(BINARY_FILE_DOWNLOAD)
+            || reading
+          #endif
+        )
           SERIAL_ECHOLNPGM("PFT:invalid");
         else if (!file_write(buffer, length))
           SERIAL_ECHOLNPGM("PFT:ioerror");
@@ -209,6 +260,29 @@ public:
         transfer_abort();
         SERIAL_ECHOLNPGM("PFT:success");
         break;
+      #if ENABLED(BINARY_FILE_DOWNLOAD)
+        case FileTransfer::OPEN_READ:
+          if (transfer_active || card.isFileOpen())   // Also a paused print's file
+            SERIAL_ECHOLNPGM("PFT:busy");
+          else {
+            if (Packet::Open::validate(buffer, length)) {
+              auto packet = Packet::Open::decode(buffer);
+              compression = packet.compression_enabled();
+              if (file_open_read(packet.filename())) {
+                SERIAL_ECHOLNPAIR("PFT:success:", card.getFileSize());
+                break;
+              }
+            }
+            SERIAL_ECHOLNPGM("PFT:fail");
+          }
+          break;
+        case FileTransfer::READ:
+          if (!reading)
+            SERIAL_ECHOLNPGM("PFT:invalid");
+          else
+            file_read(length && (buffer[0] & 0x1));
+          break;
+      #endif
       default:
         SERIAL_ECHOLNPGM("PTF:invalid");
         break;
@@ -218,9 +292,82 @@ public:
   static const uint16_t VERSION_MAJOR = 0, VERSION_MINOR = 1, VERSION_PATCH = 0, TIMEOUT = 10000, IDLE_PERIOD = 1000;
 };
 
+#if ENABLED(BINARY_MOTION_PACKETS)
+
+  /**
+   * Moves sent as binary records, skipping G-code formatting and parsing.
+   *
+   * A MOVE packet holds one or more records, each made of:
+   *   uint8_t code    0-3 for G0-G3
+   *   uint8_t fields  Bits for X Y Z E F I J, in that order
+   *   int32_t values  One for each field present, in thousandths (mm or mm/min)
+   *
+   * Coordinates are always absolute and in logical mm, regardless of G90/G91
+   * or G20/G21. Moves run through the same kinematics, leveling and arc code
+   * as G0-G3 but skip G-code-only extras like autoretract.
+   *
+   * Records are planned from the main loop once the commands queued ahead of
+   * them have run, and the packet is acknowledged when all are planned.
+   */
+  class MotionProtocol {
+  public:
+    enum class MotionPacket : uint8_t { QUERY, MOVE };
+    enum Field : uint8_t { FIELD_X, FIELD_Y, FIELD_Z, FIELD_E, FIELD_F, FIELD_I, FIELD_J };
+
+    static void process(const uint8_t packet_type, char* buffer, const uint16_t length);
+
+    // Plan as many moves as possible. Return 'false' while records remain.
+    static bool drain();
+
+    static const uint16_t VERSION_MAJOR = 0, VERSION_MINOR = 1, VERSION_PATCH = 0, SCALE = 1000;
+
+  private:
+    static uint8_t input[BINARY_STREAM_PACKET_SIZE];
+    static uint16_t input_size, input_index;
+
+    static void move(const uint8_t code, const uint8_t fields, const int32_t (&value)[FIELD_J + 1]);
+  };
+
+#endif
+
+#if ENABLED(BINARY_GCODE_STREAM)
+
+  /**
+   * G-code sent in DATA packets, optionally heatshrink-compressed, and run
+   * directly from the command queue. Lines may span packets. When the queue
+   * is full the rest of the packet is held and no more packets are read. The
+   * packet is acknowledged only once all its lines are queued, so the host is
+   * paced by the acknowledgements and can't overrun the RX buffer.
+   */
+  class GCodeStreamProtocol {
+  public:
+    enum class GCodeStream : uint8_t { QUERY, OPEN, CLOSE, DATA };
+
+    static void process(const uint8_t packet_type, char* buffer, const uint16_t length);
+
+    // Queue as many lines as possible. Return 'false' while data remains.
+    static bool drain();
+
+    static const uint16_t VERSION_MAJOR = 0, VERSION_MINOR = 1, VERSION_PATCH = 0;
+
+  private:
+    static heatshrink_decoder hsd;
+    static uint8_t input[BINARY_STREAM_PACKET_SIZE], output[32];
+    static uint16_t input_size, input_index;
+    static uint8_t output_size, output_index;
+    static char line[MAX_CMD_SIZE];
+    static uint8_t line_size;
+    static bool active, closing, compression, line_ready, in_comment;
+
+    static bool next_char(uint8_t &c);
+    static void add_char(const char c);
+  };
+
+#endif
+
 class BinaryStream {
 public:
-  enum class Protocol : uint8_t { CONTROL, FILE_TRANSFER };
+  enum class Protocol : uint8_t { CONTROL, FILE_TRANSFER, MOTION, GCODE };
 
   enum class ProtocolControl : uint8_t { SYNC = 1, CLOSE };
 
@@ -275,10 +422,12 @@ public:
     sync = 0;
     packet_retries = 0;
     buffer_next_index = 0;
+    held = 0;
+    ack_pending = false;
   }
 
   // fletchers 16 checksum
-  uint32_t checksum(uint32_t cs, uint8_t value) {
+  static uint32_t checksum(uint32_t cs, uint8_t value) {
     uint16_t cs_low = (((cs & 0xFF) + value) % 255);
     return ((((cs >> 8) + cs_low) % 255) << 8)  | cs_low;
   }
@@ -297,8 +446,32 @@ public:
     return true;
   }
 
+  void request_resend(const uint8_t packet_sync) {
+    SERIAL_ECHO_START();
+    SERIAL_ECHOLNPAIR("Resend request ", int(packet_retries));
+    SERIAL_ECHOLNPAIR("rs", packet_sync);
+  }
+
+  // Receive one packet at a time into a single buffer
   template<const size_t buffer_size>
-  void receive(char (&buffer)[buffer_size]) {
+  void receive(char (&buffer)[buffer_size]) { receive(reinterpret_cast<char (&)[1][buffer_size]>(buffer)); }
+
+  /**
+   * Receive packets into a window of buffers. The host may send the packets
+   * after the next expected one before it is acknowledged. They are held in
+   * their buffers until it arrives, then all are processed and acknowledged
+   * in order. The window must be a power of 2 so buffers follow the sync.
+   */
+  template<const size_t window, const size_t buffer_size>
+  void receive(char (&buffer)[window][buffer_size]) {
+    if (receiving) return;                              // a wait in dispatch() may call idle() and come back here
+    receiving = true;
+    receive_packets(buffer);
+    receiving = false;
+  }
+
+  template<const size_t window, const size_t buffer_size>
+  void receive_packets(char (&buffer)[window][buffer_size]) {
     uint8_t data = 0;
     millis_t transfer_window = millis() + RX_TIMESLICE;
 
@@ -318,6 +491,18 @@ public:
           packet.reset();
           stream_state = StreamState::PACKET_WAIT;
         case StreamState::PACKET_WAIT:
+          if (!drain()) return;                         // payload still pending, leave new packets waiting
+          if (ack_pending) {                            // acknowledge the packet now its payload is taken
+            ack_pending = false;
+            SERIAL_ECHOLNPAIR("ok", uint8_t(sync - 1));
+          }
+          if (TEST(held, sync % window)) {              // the next packet is already held
+            CBI(held, sync % window);
+            packet.header = held_header[sync % window];
+            packet.buffer = static_cast<char *>(&buffer[sync % window][0]);
+            stream_state = StreamState::PACKET_PROCESS;
+            break;
+          }
           if (!stream_read(data)) { idle(); return; }  // no active packet so don't wait
           packet.header.data[1] = data;
           if (packet.header.token == packet.header.HEADER_TOKEN) {
@@ -343,22 +528,33 @@ public:
             if (packet.header.checksum == packet.header_checksum) {
               // The SYNC control packet is a special case in that it doesn't require the stream sync to be correct
               if (static_cast<Protocol>(packet.header.protocol()) == Protocol::CONTROL && static_cast<ProtocolControl>(packet.header.type()) == ProtocolControl::SYNC) {
-                  SERIAL_ECHOLNPAIR("ss", sync, ",", buffer_size, ",", VERSION_MAJOR, ".", VERSION_MINOR, ".", VERSION_PATCH);
+                  SERIAL_ECHOPAIR("ss", sync, ",", buffer_size, ",", VERSION_MAJOR, ".", VERSION_MINOR, ".", VERSION_PATCH);
+                  if (window > 1) SERIAL_ECHOPAIR(",", window); // packets the host may send ahead
+                  SERIAL_EOL();
+                  held = 0;
                   stream_state = StreamState::PACKET_RESET;
                   break;
               }
-              if (packet.header.sync == sync) {
+              const uint8_t ahead = packet.header.sync - sync;
+              if (ahead < window) {
+                // The next expected packet or one after it, each with its own buffer
+                if (ahead && !packet_retries) {
+                  packet_retries++;
+                  request_resend(sync);                      // the expected packet was lost
+                }
+                CBI(held, packet.header.sync % window);      // a resend replaces the held copy
                 buffer_next_index = 0;
                 packet.bytes_received = 0;
                 if (packet.header.size) {
                   stream_state = StreamState::PACKET_DATA;
-                  packet.buffer = static_cast<char *>(&buffer[0]); // multipacket buffering not implemented, always allocate whole buffer to packet
+                  packet.buffer = static_cast<char *>(&buffer[packet.header.sync % window][0]);
                 }
                 else
                   stream_state = StreamState::PACKET_PROCESS;
               }
-              else if (packet.header.sync == sync - 1) {           // ok response must have been lost
-                SERIAL_ECHOLNPAIR("ok", packet.header.sync);  // transmit valid packet received and drop the payload
+              else if (uint8_t(sync - packet.header.sync) <= window) { // ok response must have been lost
+                if (!ack_pending || packet.header.sync != uint8_t(sync - 1))
+                  SERIAL_ECHOLNPAIR("ok", packet.header.sync);  // transmit valid packet received and drop the payload
                 stream_state = StreamState::PACKET_RESET;
               }
               else if (packet_retries) {
@@ -407,26 +603,37 @@ public:
             else {
               SERIAL_ECHO_START();
               SERIAL_ECHOLNPAIR("Packet(", packet.header.sync, ") payload corrupt");
-              stream_state = StreamState::PACKET_RESEND;
+              if (packet.header.sync == sync)
+                stream_state = StreamState::PACKET_RESEND;
+              else {
+                request_resend(packet.header.sync);       // ask for just this one, keep the rest
+                stream_state = StreamState::PACKET_RESET;
+              }
             }
           }
           break;
         case StreamState::PACKET_PROCESS:
+          if (packet.header.sync != sync) {             // hold it until the packets before it arrive
+            held_header[packet.header.sync % window] = packet.header;
+            SBI(held, packet.header.sync % window);
+            stream_state = StreamState::PACKET_RESET;
+            break;
+          }
           sync++;
           packet_retries = 0;
           bytes_received += packet.header.size;
+          stream_state = StreamState::PACKET_RESET;
 
-          SERIAL_ECHOLNPAIR("ok", packet.header.sync); // transmit valid packet received
+          // Packets feeding the planner or the queue are acknowledged once drained
+          ack_pending = is_queued(static_cast<Protocol>(packet.header.protocol()));
+          if (!ack_pending) SERIAL_ECHOLNPAIR("ok", packet.header.sync); // transmit valid packet received
           dispatch();
-          stream_state = StreamState::PACKET_RESET;
           break;
         case StreamState::PACKET_RESEND:
           if (packet_retries < MAX_RETRIES || MAX_RETRIES == 0) {
             packet_retries++;
             stream_state = StreamState::PACKET_RESET;
-            SERIAL_ECHO_START();
-            SERIAL_ECHOLNPAIR("Resend request ", int(packet_retries));
-            SERIAL_ECHOLNPAIR("rs", sync);
+            request_resend(sync);
           }
           else
             stream_state = StreamState::PACKET_ERROR;
@@ -460,11 +667,36 @@ public:
       case Protocol::FILE_TRANSFER:
         SDFileTransferProtocol::process(packet.header.type(), packet.buffer, packet.header.size); // send user data to be processed
       break;
+      #if ENABLED(BINARY_MOTION_PACKETS)
+        case Protocol::MOTION:
+          MotionProtocol::process(packet.header.type(), packet.buffer, packet.header.size);
+          break;
+      #endif
+      #if ENABLED(BINARY_GCODE_STREAM)
+        case Protocol::GCODE:
+          GCodeStreamProtocol::process(packet.header.type(), packet.buffer, packet.header.size);
+          break;
+      #endif
       default:
         SERIAL_ECHO_MSG("Unsupported Binary Protocol");
     }
   }
 
+  static bool is_queued(const Protocol protocol) {
+    return protocol == Protocol::MOTION || protocol == Protocol::GCODE;
+  }
+
+  // Pass on the payload held by the last packet. Return 'false' while some remains.
+  static bool drain() {
+    #if ENABLED(BINARY_MOTION_PACKETS)
+      if (!MotionProtocol::drain()) return false;
+    #endif
+    #if ENABLED(BINARY_GCODE_STREAM)
+      if (!GCodeStreamProtocol::drain()) return false;
+    #endif
+    return true;
+  }
+
   void idle() {
     // Some Protocols may need periodic updates without new data
     SDFileTransferProtocol::idle();
@@ -472,9 +704,16 @@ public:
 
   static const uint16_t PACKET_MAX_WAIT = 500, RX_TIMESLICE = 20, MAX_RETRIES = 0, VERSION_MAJOR = 0, VERSION_MINOR = 1, VERSION_PATCH = 0;
   uint8_t  packet_retries, sync;
+  uint8_t  held;                                        // bits for buffers holding a packet
+  bool     ack_pending, receiving;
+  Packet::Header held_header[BINARY_STREAM_WINDOW_PACKETS];
   uint16_t buffer_next_index;
   uint32_t bytes_received;
   StreamState stream_state = StreamState::PACKET_RESET;
+
+  #if ENABLED(BINARY_STREAM_WINDOW)
+    static char packet_buffer[BINARY_STREAM_WINDOW_PACKETS][BINARY_STREAM_PACKET_SIZE];
+  #endif
 };
 
 extern BinaryStream binaryStream[NUM_SERIAL];
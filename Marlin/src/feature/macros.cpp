@@ -0,0 +1,139 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../inc/MarlinConfigPre.h"
+
+#if ENABLED(GCODE_MACROS)
+
+#include "macros.h"
+
+#include "../gcode/gcode.h"
+
+GCodeMacros macros;
+
+char GCodeMacros::text[GCODE_MACROS_SLOTS][GCODE_MACROS_SLOT_SIZE + 2]; // = { 0 }
+
+#if ENABLED(PREPARSE_GCODE)
+  char GCodeMacros::parsed_text[GCODE_MACROS_SLOTS][GCODE_MACROS_SLOT_SIZE + 2];
+  GCodeParser::parsed_command_t GCodeMacros::compiled[GCODE_MACROS_SLOTS][GCODE_MACROS_SLOT_COMMANDS];
+  uint8_t GCodeMacros::compiled_count[GCODE_MACROS_SLOTS]; // = { 0 }
+#endif
+
+/**
+ * Parse the commands of a macro into its records.
+ * Return false if there are more commands than a slot can hold.
+ */
+bool GCodeMacros::compile(const uint8_t index) {
+  #if ENABLED(PREPARSE_GCODE)
+    COPY(parsed_text[index], text[index]);
+    GCodeParser::parsed_command_t current;
+    parser.save(current);
+    #if ENABLED(GCODE_MOTION_MODES)
+      const int16_t mmc = parser.motion_mode_codenum;   // Macros don't change the motion mode until they run
+      #if ENABLED(USE_GCODE_SUBCODES)
+        const uint8_t mms = parser.motion_mode_subcode;
+      #endif
+      parser.cancel_motion_mode();                    // Bare axis words before a G0-G3 get the mode at run time
+    #endif
+    uint8_t n = 0;
+    char *s = parsed_text[index];
+    for (; *s && n < GCODE_MACROS_SLOT_COMMANDS; ++n) {
+      char * const next = s + strlen(s) + 1;  // Parsing may shorten the command
+      parser.parse(s);
+      parser.save(compiled[index][n]);
+      s = next;
+    }
+    #if ENABLED(GCODE_MOTION_MODES)
+      parser.motion_mode_codenum = mmc;
+      #if ENABLED(USE_GCODE_SUBCODES)
+        parser.motion_mode_subcode = mms;
+      #endif
+    #endif
+    parser.load(current);
+    compiled_count[index] = n;
+    return !*s;
+  #else
+    UNUSED(index);
+    return true;
+  #endif
+}
+
+void GCodeMacros::compile_all() {
+  LOOP_L_N(i, GCODE_MACROS_SLOTS) compile(i);
+}
+
+/**
+ * Set a macro from commands separated by the pipe character.
+ * Return false, leaving the slot empty, if the macro is too long.
+ */
+bool GCodeMacros::set(const uint8_t index, const char *cmds) {
+  char *d = text[index];
+  const char * const end = d + GCODE_MACROS_SLOT_SIZE;
+  for (;;) {
+    while (*cmds == ' ') ++cmds;                      // Skip leading spaces
+    if (*cmds == '|') { ++cmds; continue; }           // Skip empty commands
+    if (!*cmds) break;
+    while (*cmds && *cmds != '|') {
+      if (d >= end) { text[index][0] = '\0'; compile(index); return false; }
+      *d++ = *cmds++;
+    }
+    *d++ = '\0';                                      // End of this command
+  }
+  *d = '\0';                                          // End of the macro
+  if (compile(index)) return true;
+  text[index][0] = '\0';
+  compile(index);
+  return false;
+}
+
+void GCodeMacros::run(const uint8_t index) {
+  #if ENABLED(PREPARSE_GCODE)
+    GCodeParser::parsed_command_t current;
+    parser.save(current);
+    LOOP_L_N(i, compiled_count[index]) {
+      const GCodeParser::parsed_command_t &pc = compiled[index][i];
+      if (parser.still_valid(pc))
+        parser.load(pc);
+      else
+        parser.parse(pc.command_ptr);                 // Bare axis words, for the motion mode in effect now
+      gcode.process_parsed_command(true);
+    }
+    parser.load(current);                             // Any motion mode set by the macro remains
+  #else
+    for (const char *s = text[index]; *s; s += strlen(s) + 1) {
+      char cmd[strlen(s) + 1];                        // Parse a copy, keeping the macro intact
+      strcpy(cmd, s);
+      gcode.process_subcommands_now(cmd);
+    }
+  #endif
+}
+
+void GCodeMacros::reset() {
+  LOOP_L_N(i, GCODE_MACROS_SLOTS) {
+    text[i][0] = '\0';
+    #if ENABLED(PREPARSE_GCODE)
+      compiled_count[i] = 0;
+    #endif
+  }
+}
+
+#endif // GCODE_MACROS
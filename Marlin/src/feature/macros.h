@@ -0,0 +1,65 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * G-code macros for M810-M819
+ *
+ * Each slot holds its commands back to back, each ended by a nul, with an
+ * empty command marking the end. With PREPARSE_GCODE the commands are
+ * parsed once when the macro is set and run straight from the parsed
+ * records, so a macro costs no string handling when it executes.
+ * Parsing alters the text it reads, so it works on a copy and 'text'
+ * stays as it was given for M500 to save.
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(PREPARSE_GCODE)
+  #include "../gcode/parser.h"
+#endif
+
+class GCodeMacros {
+public:
+  static char text[GCODE_MACROS_SLOTS][GCODE_MACROS_SLOT_SIZE + 2];
+
+  static bool set(const uint8_t index, const char *cmds);
+  static void run(const uint8_t index);
+
+  static inline bool is_set(const uint8_t index) { return text[index][0]; }
+
+  // Rebuild the parsed records after the text is loaded
+  static void compile_all();
+
+  static void reset();
+
+private:
+  #if ENABLED(PREPARSE_GCODE)
+    static char parsed_text[GCODE_MACROS_SLOTS][GCODE_MACROS_SLOT_SIZE + 2];
+    static GCodeParser::parsed_command_t compiled[GCODE_MACROS_SLOTS][GCODE_MACROS_SLOT_COMMANDS];
+    static uint8_t compiled_count[GCODE_MACROS_SLOTS];
+  #endif
+
+  static bool compile(const uint8_t index);
+};
+
+extern GCodeMacros macros;
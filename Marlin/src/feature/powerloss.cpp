@@ -39,6 +39,10 @@ const char PrintJobRecovery::filename[5] = "/PLR";
 uint8_t PrintJobRecovery::queue_index_r;
 uint32_t PrintJobRecovery::cmd_sdpos, // = 0
          PrintJobRecovery::sdpos[BUFSIZE];
+#if ENABLED(POWER_LOSS_JOURNAL)
+  uint32_t PrintJobRecovery::journal_block, // = 0
+           PrintJobRecovery::journal_sequence;
+#endif
 
 #include "../sd/cardreader.h"
 #include "../lcd/ultralcd.h"
@@ -54,6 +58,11 @@ uint32_t PrintJobRecovery::cmd_sdpos, // = 0
   #include "fwretract.h"
 #endif
 
+#if ENABLED(POWER_LOSS_JOURNAL)
+  #include "../libs/crc16.h"
+  static_assert(sizeof(journal_record_t) <= 512, "The job recovery info is too large for a journal record.");
+#endif
+
 #define DEBUG_OUT ENABLED(DEBUG_POWER_LOSS_RECOVERY)
 #include "../core/debug_out.h"
 
@@ -72,7 +81,12 @@ PrintJobRecovery recovery;
 /**
  * Clear the recovery info
  */
-void PrintJobRecovery::init() { memset(&info, 0, sizeof(info)); }
+void PrintJobRecovery::init() {
+  memset(&info, 0, sizeof(info));
+  #if ENABLED(POWER_LOSS_JOURNAL)
+    journal_block = 0;
+  #endif
+}
 
 /**
  * Enable or disable then call changed()
@@ -120,13 +134,53 @@ void PrintJobRecovery::purge() {
  * Load the recovery data, if it exists
  */
 void PrintJobRecovery::load() {
-  if (exists()) {
+  #if ENABLED(POWER_LOSS_JOURNAL)
+    journal_record_t rec;
+    init();
+    if (read_journal(rec)) info = rec.info;
+  #else
+    if (exists()) {
+      open(true);
+      (void)file.read(&info, sizeof(info));
+      close();
+    }
+  #endif
+  debug(PSTR("Load"));
+}
+
+#if ENABLED(POWER_LOSS_JOURNAL)
+
+  // The CRC covers everything after the crc field
+  static uint16_t record_crc(const journal_record_t &rec) {
+    uint16_t crc = 0;
+    crc16(&crc, &rec.size, sizeof(rec) - sizeof(rec.crc));
+    return crc;
+  }
+
+  /**
+   * Find the newest good record in the journal, and number the next
+   * record after it. Return false if there is none.
+   */
+  bool PrintJobRecovery::read_journal(journal_record_t &rec) {
+    if (!exists()) return false;
     open(true);
-    (void)file.read(&info, sizeof(info));
+    bool found = false;
+    if (file.fileSize() == (POWER_LOSS_JOURNAL_BLOCKS) * 512UL) {
+      journal_record_t r;
+      LOOP_L_N(i, POWER_LOSS_JOURNAL_BLOCKS) {
+        if (!file.seekSet(i * 512UL) || file.read(&r, sizeof(r)) != int16_t(sizeof(r))) break;
+        if (r.size == sizeof(r.info) && (!found || r.sequence > rec.sequence) && r.crc == record_crc(r)) {
+          rec = r;
+          found = true;
+        }
+      }
+    }
     close();
+    if (found) journal_sequence = rec.sequence + 1;
+    return found;
   }
-  debug(PSTR("Load"));
-}
+
+#endif
 
 /**
  * Set info fields that won't change
@@ -134,6 +188,9 @@ void PrintJobRecovery::load() {
 void PrintJobRecovery::prepare() {
   card.getAbsFilename(info.sd_filename);  // SD filename
   cmd_sdpos = 0;
+  #if ENABLED(POWER_LOSS_JOURNAL)
+    journal_block = 0;                    // The card may have changed
+  #endif
 }
 
 /**
@@ -273,11 +330,37 @@ void PrintJobRecovery::write() {
 
   debug(PSTR("Write"));
 
-  open(false);
-  file.seekSet(0);
-  const int16_t ret = file.write(&info, sizeof(info));
-  if (ret == -1) DEBUG_ECHOLNPGM("Power-loss file write failed.");
-  if (!file.close()) DEBUG_ECHOLNPGM("Power-loss file close failed.");
+  #if ENABLED(POWER_LOSS_JOURNAL)
+
+    journal_record_t rec;
+
+    // Open the journal, carrying on from any records already in it
+    if (!journal_block) {
+      (void)read_journal(rec);
+      if (!card.openJobRecoveryJournal(journal_block)) {
+        DEBUG_ECHOLNPGM("Power-loss journal open failed.");
+        return;
+      }
+    }
+
+    // Write the record over the oldest one
+    rec.size = sizeof(info);
+    rec.sequence = journal_sequence;
+    rec.info = info;
+    rec.crc = record_crc(rec);
+    if (!card.writeJobRecoveryBlock(journal_block + journal_sequence % (POWER_LOSS_JOURNAL_BLOCKS), &rec, sizeof(rec)))
+      DEBUG_ECHOLNPGM("Power-loss journal write failed.");
+    journal_sequence++;
+
+  #else
+
+    open(false);
+    file.seekSet(0);
+    const int16_t ret = file.write(&info, sizeof(info));
+    if (ret == -1) DEBUG_ECHOLNPGM("Power-loss file write failed.");
+    if (!file.close()) DEBUG_ECHOLNPGM("Power-loss file close failed.");
+
+  #endif
 }
 
 /**
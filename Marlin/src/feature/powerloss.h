@@ -112,6 +112,16 @@ typedef struct {
 
 } job_recovery_info_t;
 
+#if ENABLED(POWER_LOSS_JOURNAL)
+  // A save in the recovery journal, one to a block
+  typedef struct {
+    uint16_t crc;             // CRC16 of the rest of the record
+    uint16_t size;            // Size of the info, so records from another build don't match
+    uint32_t sequence;        // Count of saves, to find the newest
+    job_recovery_info_t info;
+  } journal_record_t;
+#endif
+
 class PrintJobRecovery {
   public:
     static const char filename[5];
@@ -179,6 +189,12 @@ class PrintJobRecovery {
   private:
     static void write();
 
+  #if ENABLED(POWER_LOSS_JOURNAL)
+    static uint32_t journal_block,    //!< First block of the journal, or 0 to open it on the next write
+                    journal_sequence; //!< Sequence number of the next record
+    static bool read_journal(journal_record_t &rec);
+  #endif
+
   #if ENABLED(BACKUP_POWER_SUPPLY)
     static void raise_z();
   #endif
@@ -0,0 +1,95 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(GCODE_PROFILER)
+
+#include "profiler.h"
+
+GCodeProfiler profiler;
+
+GCodeProfiler::profile_t GCodeProfiler::profile[GCODE_PROFILER_SLOTS]; // = { 0 }
+uint32_t GCodeProfiler::wait_us, GCodeProfiler::sync_us,
+         GCodeProfiler::start_us, GCodeProfiler::start_wait_us, GCodeProfiler::start_sync_us;
+char GCodeProfiler::cur_letter;
+uint16_t GCodeProfiler::cur_codenum;
+
+void GCodeProfiler::start(const char letter, const int codenum) {
+  cur_letter = letter;
+  cur_codenum = codenum;
+  start_wait_us = wait_us;
+  start_sync_us = sync_us;
+  start_us = micros();
+}
+
+void GCodeProfiler::stop() {
+  const uint32_t elapsed = micros() - start_us;
+
+  // Find the command's slot, or claim a free one. The last slot
+  // collects everything once the others are taken.
+  profile_t *p = profile;
+  for (uint8_t i = 0; i < GCODE_PROFILER_SLOTS - 1; ++i, ++p) {
+    if (!p->letter) { p->letter = cur_letter; p->codenum = cur_codenum; break; }
+    if (p->letter == cur_letter && p->codenum == cur_codenum) break;
+  }
+  if (p == &profile[GCODE_PROFILER_SLOTS - 1]) p->letter = '?';
+
+  p->count++;
+  NOLESS(p->max_us, elapsed);
+  p->total.add(elapsed);
+  p->wait.add(wait_us - start_wait_us);
+  p->sync.add(sync_us - start_sync_us);
+}
+
+/**
+ * Report each command code seen since the last reset:
+ *   G1 Count:12345 Total:6789.012ms Max:2345us Wait:1234.567ms Sync:0.000ms
+ * Wait and Sync are parts of Total spent waiting on the planner.
+ */
+void GCodeProfiler::report() {
+  auto echo_ms = [](PGM_P const pre, const tally_t &t) {
+    serialprintPGM(pre);
+    SERIAL_ECHO(t.ms);
+    SERIAL_CHAR('.');
+    if (t.us < 100) SERIAL_CHAR('0');
+    if (t.us < 10) SERIAL_CHAR('0');
+    SERIAL_ECHO(t.us);
+    SERIAL_ECHOPGM("ms");
+  };
+  LOOP_L_N(i, GCODE_PROFILER_SLOTS) {
+    const profile_t &p = profile[i];
+    if (!p.letter) break;
+    SERIAL_CHAR(p.letter);
+    if (p.letter != '?') SERIAL_ECHO(p.codenum);
+    SERIAL_ECHOPAIR(" Count:", p.count);
+    echo_ms(PSTR(" Total:"), p.total);
+    SERIAL_ECHOPAIR(" Max:", p.max_us, "us");
+    echo_ms(PSTR(" Wait:"), p.wait);
+    echo_ms(PSTR(" Sync:"), p.sync);
+    SERIAL_EOL();
+  }
+}
+
+void GCodeProfiler::reset() { ZERO(profile); }
+
+#endif // GCODE_PROFILER
@@ -0,0 +1,67 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * G-code execution profiler
+ *
+ * Times every command run from the queue and tallies the results per
+ * command code, along with the time spent inside each command waiting
+ * for a free planner block and in planner.synchronize().
+ */
+
+#include "../inc/MarlinConfigPre.h"
+
+class GCodeProfiler {
+public:
+  // Milliseconds with a microsecond remainder, so totals don't wrap for weeks
+  typedef struct {
+    uint32_t ms;
+    uint16_t us;
+    void add(const uint32_t d) { const uint32_t t = us + d; ms += t / 1000; us = t % 1000; }
+  } tally_t;
+
+  typedef struct {
+    char letter;                    // G, M, T, or '?' for commands with no slot
+    uint16_t codenum;
+    uint32_t count, max_us;
+    tally_t total, wait, sync;
+  } profile_t;
+
+  static profile_t profile[GCODE_PROFILER_SLOTS];
+
+  // Running totals, bumped by the planner
+  static uint32_t wait_us, sync_us;
+
+  static void start(const char letter, const int codenum);
+  static void stop();
+
+  static void report();
+  static void reset();
+
+private:
+  static char cur_letter;
+  static uint16_t cur_codenum;
+  static uint32_t start_us, start_wait_us, start_sync_us;
+};
+
+extern GCodeProfiler profiler;
@@ -25,10 +25,8 @@
 #if ENABLED(GCODE_MACROS)
 
 #include "../../gcode.h"
-#include "../../queue.h"
 #include "../../parser.h"
-
-char gcode_macros[GCODE_MACROS_SLOTS][GCODE_MACROS_SLOT_SIZE + 1] = {{ 0 }};
+#include "../../../feature/macros.h"
 
 /**
  * M810_819: Set/execute a G-code macro.
@@ -45,20 +43,12 @@ void GcodeSuite::M810_819() {
 
   if (len) {
     // Set a macro
-    if (len > GCODE_MACROS_SLOT_SIZE)
+    if (len > GCODE_MACROS_SLOT_SIZE || !macros.set(index, parser.string_arg))
       SERIAL_ERROR_MSG("Macro too long.");
-    else {
-      char c, *s = parser.string_arg, *d = gcode_macros[index];
-      do {
-        c = *s++;
-        *d++ = c == '|' ? '\n' : c;
-      } while (c);
-    }
   }
-  else {
+  else if (macros.is_set(index)) {
     // Execute a macro
-    char * const cmd = gcode_macros[index];
-    if (strlen(cmd)) process_subcommands_now(cmd);
+    macros.run(index);
   }
 }
 
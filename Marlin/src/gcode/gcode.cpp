@@ -53,6 +53,10 @@ GcodeSuite gcode;
   #include "../feature/cancel_object.h"
 #endif
 
+#if ENABLED(GCODE_PROFILER)
+  #include "../feature/profiler.h"
+#endif
+
 #include "../MarlinCore.h" // for idle()
 
 millis_t GcodeSuite::previous_move_ms;
@@ -226,20 +230,24 @@ void GcodeSuite::dwell(millis_t time) {
 void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
   KEEPALIVE_STATE(IN_HANDLER);
 
-  // Handle a known G, M, or T
-  switch (parser.command_letter) {
-    case 'G': switch (parser.codenum) {
+  // Moves make up nearly all of a print, so dispatch them first
+  if (parser.command_letter == 'G' && parser.codenum <= 1)
+    G0_G1(                                                        // G0: Fast Move, G1: Linear Move
+      #if IS_SCARA || defined(G0_FEEDRATE)
+        parser.codenum == 0
+      #endif
+    );
+
+  #if ENABLED(ARC_SUPPORT) && DISABLED(SCARA)
+    else if (parser.command_letter == 'G' && parser.codenum <= 3)
+      G2_G3(parser.codenum == 2);                                 // G2: CW ARC, G3: CCW ARC
+  #endif
 
-      case 0: case 1: G0_G1(                                      // G0: Fast Move, G1: Linear Move
-                        #if IS_SCARA || defined(G0_FEEDRATE)
-                          parser.codenum == 0
-                        #endif
-                      );
-                      break;
+  // Handle any other known G, M, or T
+  else switch (parser.command_letter) {
+    case 'G': switch (parser.codenum) {
 
-      #if ENABLED(ARC_SUPPORT) && DISABLED(SCARA)
-        case 2: case 3: G2_G3(parser.codenum == 2); break;        // G2: CW ARC, G3: CCW ARC
-      #endif
+      // G0-G3 are handled above
 
       case 4: G4(); break;                                        // G4: Dwell
 
@@ -726,6 +734,18 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
         case 575: M575(); break;                                  // M575: Set serial baudrate
       #endif
 
+      #if ENABLED(CREDIT_FLOW_CONTROL)
+        case 576: M576(); break;                                  // M576: Set credit flow control
+      #endif
+
+      #if ENABLED(SERIAL_PORT_STATS)
+        case 577: M577(); break;                                  // M577: Report serial port statistics
+      #endif
+
+      #if ENABLED(GCODE_PROFILER)
+        case 578: M578(); break;                                  // M578: Report command execution profile
+      #endif
+
       #if ENABLED(ADVANCED_PAUSE_FEATURE)
         case 600: M600(); break;                                  // M600: Pause for Filament Change
         case 603: M603(); break;                                  // M603: Configure Filament Change
@@ -889,7 +909,7 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
  * This is called from the main loop()
  */
 void GcodeSuite::process_next_command() {
-  char * const current_command = queue.command_buffer[queue.index_r];
+  char * const current_command = queue.command(queue.index_r);
 
   PORT_REDIRECT(queue.port[queue.index_r]);
 
@@ -902,13 +922,25 @@ void GcodeSuite::process_next_command() {
     SERIAL_ECHOLN(current_command);
     #if ENABLED(M100_FREE_MEMORY_DUMPER)
       SERIAL_ECHOPAIR("slot:", queue.index_r);
-      M100_dump_routine(PSTR("   Command Queue:"), &queue.command_buffer[0][0], &queue.command_buffer[BUFSIZE - 1][MAX_CMD_SIZE - 1]);
+      M100_dump_routine(PSTR("   Command Queue:"), queue.command_buffer, &queue.command_buffer[COMMAND_BUFFER_SIZE - 1]);
     #endif
   }
 
   // Parse the next command in the queue
-  parser.parse(current_command);
-  process_parsed_command();
+  #if ENABLED(PREPARSE_GCODE)
+    if (parser.still_valid(queue.parsed[queue.index_r]))
+      parser.load(queue.parsed[queue.index_r]);
+    else
+  #endif
+      parser.parse(current_command);
+
+  #if ENABLED(GCODE_PROFILER)
+    profiler.start(parser.command_letter, parser.codenum);
+    process_parsed_command();
+    profiler.stop();
+  #else
+    process_parsed_command();
+  #endif
 }
 
 /**
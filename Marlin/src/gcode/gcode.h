@@ -96,6 +96,7 @@
  * M24  - Start/resume SD print. (Requires SDSUPPORT)
  * M25  - Pause SD print. (Requires SDSUPPORT)
  * M26  - Set SD position in bytes: "M26 S12345". (Requires SDSUPPORT)
+ *        OR, with 'N<line>' or 'L<layer>' go to a line or layer, or report both. (Requires SD_LINE_INDEX)
  * M27  - Report SD print status. (Requires SDSUPPORT)
  *        OR, with 'S<seconds>' set the SD status auto-report interval. (Requires AUTO_REPORT_SD_STATUS)
  *        OR, with 'C' get the current filename.
@@ -226,6 +227,9 @@
  * M524 - Abort the current SD print job started with M24. (Requires SDSUPPORT)
  * M540 - Enable/disable SD card abort on endstop hit: "M540 S<state>". (Requires SD_ABORT_ON_ENDSTOP_HIT)
  * M569 - Enable stealthChop on an axis. (Requires at least one _DRIVER_TYPE to be TMC2130/2160/2208/2209/5130/5160)
+ * M576 - Get or set credit-based serial flow control: "M576 S<bool>". (Requires CREDIT_FLOW_CONTROL)
+ * M577 - Report serial port statistics: "M577 [R]". (Requires SERIAL_PORT_STATS)
+ * M578 - Report the time spent running each command code: "M578 [R]". (Requires GCODE_PROFILER)
  * M600 - Pause for filament change: "M600 X<pos> Y<pos> Z<raise> E<first_retract> L<later_retract>". (Requires ADVANCED_PAUSE_FEATURE)
  * M603 - Configure filament change: "M603 T<tool> U<unload_length> L<load_length>". (Requires ADVANCED_PAUSE_FEATURE)
  * M605 - Set Dual X-Carriage movement mode: "M605 S<mode> [X<x_offset>] [R<temp_offset>]". (Requires DUAL_X_CARRIAGE)
@@ -853,6 +857,18 @@ private:
     static void M575();
   #endif
 
+  #if ENABLED(CREDIT_FLOW_CONTROL)
+    static void M576();
+  #endif
+
+  #if ENABLED(SERIAL_PORT_STATS)
+    static void M577();
+  #endif
+
+  #if ENABLED(GCODE_PROFILER)
+    static void M578();
+  #endif
+
   #if ENABLED(ADVANCED_PAUSE_FEATURE)
     static void M600();
     static void M603();
@@ -56,9 +56,21 @@ void GcodeSuite::M115() {
     // SERIAL_XON_XOFF
     cap_line(PSTR("SERIAL_XON_XOFF"), ENABLED(SERIAL_XON_XOFF));
 
+    // CREDIT_FLOW (M576)
+    cap_line(PSTR("CREDIT_FLOW"), ENABLED(CREDIT_FLOW_CONTROL));
+
     // BINARY_FILE_TRANSFER (M28 B1)
     cap_line(PSTR("BINARY_FILE_TRANSFER"), ENABLED(BINARY_FILE_TRANSFER));
 
+    // BINARY_MOTION_PACKETS (M28 B1)
+    cap_line(PSTR("BINARY_MOTION_PACKETS"), ENABLED(BINARY_MOTION_PACKETS));
+
+    // BINARY_GCODE_STREAM (M28 B1)
+    cap_line(PSTR("BINARY_GCODE_STREAM"), ENABLED(BINARY_GCODE_STREAM));
+
+    // BINARY_FILE_DOWNLOAD (M28 B1)
+    cap_line(PSTR("BINARY_FILE_DOWNLOAD"), ENABLED(BINARY_FILE_DOWNLOAD));
+
     // EEPROM (M500, M501)
     cap_line(PSTR("EEPROM"), ENABLED(EEPROM_SETTINGS));
 
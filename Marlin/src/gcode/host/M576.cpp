@@ -0,0 +1,52 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(CREDIT_FLOW_CONTROL)
+
+#include "../gcode.h"
+#include "../queue.h"
+
+/**
+ * M576: Get or set credit-based flow control for the serial port sending the command
+ *
+ *   S<bool> Optional. Enable or disable credit flow.
+ *
+ * With credit flow the host may have up to CREDIT_FLOW_WINDOW bytes sent
+ * but not yet acknowledged. Lines are no longer answered with "ok" one by
+ * one. Instead "ok C<bytes>" returns credit for bytes taken from the receive
+ * buffer, in batches. A "Resend" request returns all outstanding credit.
+ */
+void GcodeSuite::M576() {
+  const uint8_t pn = (
+    #if NUM_SERIAL > 1
+      queue.port[queue.index_r] < 0 ? 0 : queue.port[queue.index_r]
+    #else
+      0
+    #endif
+  );
+  if (parser.seen('S')) queue.set_credit_flow(pn, parser.value_bool());
+  SERIAL_ECHOLNPAIR("CREDIT_FLOW:", queue.credit_flow[pn] ? int(CREDIT_FLOW_WINDOW) : 0);
+}
+
+#endif // CREDIT_FLOW_CONTROL
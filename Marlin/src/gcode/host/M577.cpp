@@ -0,0 +1,44 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(SERIAL_PORT_STATS)
+
+#include "../gcode.h"
+#include "../queue.h"
+
+/**
+ * M577: Report serial port statistics
+ *
+ *   R  Reset the statistics after reporting
+ */
+void GcodeSuite::M577() {
+  LOOP_L_N(i, NUM_SERIAL) {
+    const GCodeQueue::port_stats_t &s = queue.port_stats[i];
+    SERIAL_ECHO_START();
+    SERIAL_ECHOLNPAIR("Port ", int(i), " Lines:", s.lines, " Bytes:", s.bytes, " Errors:", s.errors, " Max queued:", int(s.max_queued));
+  }
+  if (parser.seen('R')) ZERO(queue.port_stats);
+}
+
+#endif // SERIAL_PORT_STATS
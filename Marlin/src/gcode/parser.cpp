@@ -70,6 +70,14 @@ int GCodeParser::codenum;
   char *GCodeParser::command_args; // start of parameters
 #endif
 
+#if ENABLED(PREPARSE_GCODE) && ENABLED(GCODE_MOTION_MODES)
+  // The motion mode as of the last queued command
+  static int16_t queued_motion_mode_codenum = -1;
+  #if ENABLED(USE_GCODE_SUBCODES)
+    static uint8_t queued_motion_mode_subcode;
+  #endif
+#endif
+
 // Create a global instance of the GCode parser singleton
 GCodeParser parser;
 
@@ -112,6 +120,25 @@ void GCodeParser::reset() {
 
 #endif
 
+#if ENABLED(GCODE_MOTION_MODES)
+
+  #if ENABLED(ARC_SUPPORT)
+    #define GTOP 3
+  #else
+    #define GTOP 1
+  #endif
+
+  // G-codes that apply to the bare axis words after them
+  static inline bool sets_motion_mode(const int code) {
+    return code <= GTOP || code == 5
+      #if ENABLED(G38_PROBE_TARGET)
+        || code == 38
+      #endif
+    ;
+  }
+
+#endif
+
 // Populate all fields by parsing a single line of GCode
 // 58 bytes of SRAM are used to speed up seen/value
 void GCodeParser::parse(char *p) {
@@ -152,14 +179,6 @@ void GCodeParser::parse(char *p) {
     starpos[1] = '\0';
   }
 
-  #if ENABLED(GCODE_MOTION_MODES)
-    #if ENABLED(ARC_SUPPORT)
-      #define GTOP 3
-    #else
-      #define GTOP 1
-    #endif
-  #endif
-
   // Bail if the letter is not G, M, or T
   // (or a valid parameter for the current motion mode)
   switch (letter) {
@@ -206,17 +225,16 @@ void GCodeParser::parse(char *p) {
       while (*p == ' ') p++;
 
       #if ENABLED(GCODE_MOTION_MODES)
-        if (letter == 'G' && (codenum <= GTOP || codenum == 5
-                                #if ENABLED(G38_PROBE_TARGET)
-                                  || codenum == 38
-                                #endif
-                             )
-        ) {
+        if (letter == 'G' && sets_motion_mode(codenum)) {
           motion_mode_codenum = codenum;
           #if ENABLED(USE_GCODE_SUBCODES)
             motion_mode_subcode = subcode;
           #endif
         }
+        #if ENABLED(PREPARSE_GCODE)
+          else if (letter == 'G' && codenum == 80)
+            cancel_motion_mode();   // G80 affects the commands queued after it
+        #endif
       #endif
 
       break;
@@ -353,6 +371,150 @@ void GCodeParser::parse(char *p) {
   }
 }
 
+/**
+ * Up to 7 significant digits and 10 decimal places are converted with a
+ * single rounding, matching strtof. Longer values are within one ulp.
+ * Digits beyond the 9th or past 1e-10 are dropped. Values too large for
+ * a float become infinity.
+ */
+float GCodeParser::decimal_float(const char *p) {
+  static const float pow10[] PROGMEM = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+  constexpr uint32_t full = 100000000UL;  // More digits may overflow
+
+  const bool neg = *p == '-';
+  if (neg || *p == '+') ++p;
+
+  uint32_t digits = 0;
+  int8_t scale = 0;
+  for (; NUMERIC(*p); ++p) {
+    if (digits < full) digits = digits * 10 + (*p - '0'); else if (scale < 40) ++scale; // Past FLT_MAX, as strtof
+  }
+  if (*p == '.') {
+    for (++p; NUMERIC(*p) && digits < full && scale > -int8_t(COUNT(pow10) - 1); ++p) {
+      digits = digits * 10 + (*p - '0');
+      --scale;
+    }
+  }
+
+  float f = digits;
+  if (scale < 0) f /= pgm_read_float(&pow10[-scale]);
+  else while (scale--) f *= 10;
+
+  return neg ? -f : f;
+}
+
+// Get the digits of an integer. Return false if they overflow.
+static bool decimal_digits(const char *p, uint32_t &v) {
+  v = 0;
+  for (; NUMERIC(*p); ++p) {
+    const uint8_t d = *p - '0';
+    if (v > (UINT32_MAX - d) / 10) return false;
+    v = v * 10 + d;
+  }
+  return true;
+}
+
+// Out of range values are clamped, as with strtoul and strtol
+uint32_t GCodeParser::decimal_ulong(const char *p) {
+  const bool neg = *p == '-';
+  if (neg || *p == '+') ++p;
+  uint32_t v;
+  if (!decimal_digits(p, v)) return UINT32_MAX;
+  return neg ? -v : v;
+}
+
+int32_t GCodeParser::decimal_long(const char *p) {
+  const bool neg = *p == '-';
+  if (neg || *p == '+') ++p;
+  uint32_t v;
+  const bool ok = decimal_digits(p, v);
+  if (neg) return (!ok || v >= 0x80000000UL) ? INT32_MIN : -int32_t(v);
+  return (!ok || v > INT32_MAX) ? INT32_MAX : int32_t(v);
+}
+
+#if ENABLED(PREPARSE_GCODE)
+
+  void GCodeParser::save(parsed_command_t &pc) {
+    pc.command_ptr = command_ptr;
+    pc.string_arg = string_arg;
+    pc.value_ptr = value_ptr;                         // The last seen() value of a running command
+    pc.command_letter = command_letter;
+    pc.codenum = codenum;
+    #if ENABLED(USE_GCODE_SUBCODES)
+      pc.subcode = subcode;
+    #endif
+    pc.codebits = codebits;
+    COPY(pc.param, param);
+    #if ENABLED(GCODE_MOTION_MODES)
+      pc.motion_mode_codenum = motion_mode_codenum;
+      #if ENABLED(USE_GCODE_SUBCODES)
+        pc.motion_mode_subcode = motion_mode_subcode;
+      #endif
+      const char c = command_ptr ? *command_ptr : '\0';   // The letter, unless taken from the motion mode
+      pc.modal = c != command_letter && c != command_letter + 'a' - 'A';
+    #endif
+  }
+
+  void GCodeParser::load(const parsed_command_t &pc) {
+    command_ptr = pc.command_ptr;
+    string_arg = pc.string_arg;
+    value_ptr = pc.value_ptr;
+    command_letter = pc.command_letter;
+    codenum = pc.codenum;
+    #if ENABLED(USE_GCODE_SUBCODES)
+      subcode = pc.subcode;
+    #endif
+    codebits = pc.codebits;
+    COPY(param, pc.param);
+    #if ENABLED(GCODE_MOTION_MODES)
+      if (!pc.modal && command_letter == 'G' && (sets_motion_mode(codenum) || codenum == 80)) {
+        motion_mode_codenum = pc.motion_mode_codenum; // Set (or cancel) the motion mode, as parse() does
+        #if ENABLED(USE_GCODE_SUBCODES)
+          motion_mode_subcode = pc.motion_mode_subcode;
+        #endif
+      }
+    #endif
+  }
+
+  /**
+   * Parse a command as it enters the queue, so it's ready to run when it
+   * gets to the head. The current command may still be running, so its
+   * state is saved and restored. Queued commands keep their own motion
+   * mode, since they are parsed ahead of the ones being executed.
+   * With nothing else queued they pick up the current motion mode.
+   * Bare axis words whose motion mode has changed by the time they run
+   * are parsed again (see still_valid).
+   */
+  void GCodeParser::preparse(char * const p, parsed_command_t &pc, const bool behind_queued/*=true*/) {
+    parsed_command_t current;
+    save(current);
+    #if ENABLED(GCODE_MOTION_MODES)
+      const int16_t mmc = motion_mode_codenum;
+      if (behind_queued) motion_mode_codenum = queued_motion_mode_codenum;
+      #if ENABLED(USE_GCODE_SUBCODES)
+        const uint8_t mms = motion_mode_subcode;
+        if (behind_queued) motion_mode_subcode = queued_motion_mode_subcode;
+      #endif
+    #else
+      UNUSED(behind_queued);
+    #endif
+
+    parse(p);
+    save(pc);
+
+    #if ENABLED(GCODE_MOTION_MODES)
+      queued_motion_mode_codenum = motion_mode_codenum;
+      motion_mode_codenum = mmc;
+      #if ENABLED(USE_GCODE_SUBCODES)
+        queued_motion_mode_subcode = motion_mode_subcode;
+        motion_mode_subcode = mms;
+      #endif
+    #endif
+    load(current);
+  }
+
+#endif // PREPARSE_GCODE
+
 #if ENABLED(CNC_COORDINATE_SYSTEMS)
 
   // Parse the next parameter as a new command
@@ -101,6 +101,46 @@ public:
     static void debug();
   #endif
 
+  #if ENABLED(PREPARSE_GCODE)
+    // The parsed state of a queued command, restored by load()
+    typedef struct {
+      char *command_ptr, *string_arg, *value_ptr, command_letter;
+      int codenum;
+      #if ENABLED(USE_GCODE_SUBCODES)
+        uint8_t subcode;
+      #endif
+      uint32_t codebits;
+      uint8_t param[26];
+      #if ENABLED(GCODE_MOTION_MODES)
+        int16_t motion_mode_codenum;      // The motion mode after the command
+        #if ENABLED(USE_GCODE_SUBCODES)
+          uint8_t motion_mode_subcode;
+        #endif
+        bool modal;                       // No command letter, so parsed with the motion mode
+      #endif
+    } parsed_command_t;
+
+    static void save(parsed_command_t &pc);
+    static void load(const parsed_command_t &pc);
+
+    // A command that relied on a motion mode that has changed since it
+    // was parsed has to be parsed again to run
+    static inline bool still_valid(const parsed_command_t &pc) {
+      #if ENABLED(GCODE_MOTION_MODES)
+        if (pc.modal && (pc.motion_mode_codenum != motion_mode_codenum
+          #if ENABLED(USE_GCODE_SUBCODES)
+            || pc.motion_mode_subcode != motion_mode_subcode
+          #endif
+        )) return false;
+      #endif
+      return pc.command_ptr != nullptr;
+    }
+
+    // Parse a queued command without disturbing the current one.
+    // Pass 'behind_queued' false if no other commands are waiting.
+    static void preparse(char * const p, parsed_command_t &pc, const bool behind_queued=true);
+  #endif
+
   // Reset is done before parsing
   static void reset();
 
@@ -244,29 +284,21 @@ public:
   // The value as a string
   static inline char* value_string() { return value_ptr; }
 
-  // Float removes 'E' to prevent scientific notation interpretation
-  static inline float value_float() {
-    if (value_ptr) {
-      char *e = value_ptr;
-      for (;;) {
-        const char c = *e;
-        if (c == '\0' || c == ' ') break;
-        if (c == 'E' || c == 'e') {
-          *e = '\0';
-          const float ret = strtof(value_ptr, nullptr);
-          *e = c;
-          return ret;
-        }
-        ++e;
-      }
-      return strtof(value_ptr, nullptr);
-    }
-    return 0;
-  }
-
-  // Code value as a long or ulong
-  static inline int32_t value_long() { return value_ptr ? strtol(value_ptr, nullptr, 10) : 0L; }
-  static inline uint32_t value_ulong() { return value_ptr ? strtoul(value_ptr, nullptr, 10) : 0UL; }
+  /**
+   * Convert a plain decimal number, [-+]?[0-9]*(.[0-9]*)? stopping at any
+   * other character. There's no exponent, so 'E' can follow a value.
+   * Faster and smaller than strtof / strtol, and free of locale.
+   */
+  static float decimal_float(const char *p);
+  static uint32_t decimal_ulong(const char *p);
+  static int32_t decimal_long(const char *p);
+
+  // Code value as a float
+  static inline float value_float() { return value_ptr ? decimal_float(value_ptr) : 0; }
+
+  // Code value as a long or ulong. A fraction is ignored.
+  static inline int32_t value_long() { return value_ptr ? decimal_long(value_ptr) : 0L; }
+  static inline uint32_t value_ulong() { return value_ptr ? decimal_ulong(value_ptr) : 0UL; }
 
   // Code value for use as time
   static inline millis_t value_millis() { return value_ulong(); }
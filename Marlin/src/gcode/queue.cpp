@@ -56,7 +56,8 @@ long gcode_N, GCodeQueue::last_N;
 
 /**
  * GCode Command Queue
- * A simple ring buffer of BUFSIZE command strings.
+ * A ring buffer of up to BUFSIZE command strings, packed end-to-end
+ * into COMMAND_BUFFER_SIZE bytes so short commands take less room.
  *
  * Commands are copied into this buffer by the command injectors
  * (immediate, serial, sd card) and they are processed sequentially by
@@ -67,13 +68,34 @@ uint8_t GCodeQueue::length = 0,  // Count of commands in the queue
         GCodeQueue::index_r = 0, // Ring buffer read position
         GCodeQueue::index_w = 0; // Ring buffer write position
 
-char GCodeQueue::command_buffer[BUFSIZE][MAX_CMD_SIZE];
+char GCodeQueue::command_buffer[COMMAND_BUFFER_SIZE];
+uint16_t GCodeQueue::command_pos[BUFSIZE],
+         GCodeQueue::buffer_w = 0; // Write position in command_buffer
+
+#if ENABLED(PREPARSE_GCODE)
+  GCodeParser::parsed_command_t GCodeQueue::parsed[BUFSIZE];
+#endif
 
 /*
  * The port that the command was received on
  */
 #if NUM_SERIAL > 1
   int16_t GCodeQueue::port[BUFSIZE];
+
+  // Commands in the queue from each port
+  static uint8_t port_length[NUM_SERIAL];
+
+  #ifdef SERIAL_QUEUE_LIMITS
+    static const uint8_t port_limit[NUM_SERIAL] = SERIAL_QUEUE_LIMITS;
+    #define PORT_HAS_ROOM(P) (port_length[P] < port_limit[P])
+  #endif
+#endif
+#ifndef PORT_HAS_ROOM
+  #define PORT_HAS_ROOM(P) true
+#endif
+
+#if ENABLED(SERIAL_PORT_STATS)
+  GCodeQueue::port_stats_t GCodeQueue::port_stats[NUM_SERIAL];
 #endif
 
 /**
@@ -83,6 +105,54 @@ char GCodeQueue::command_buffer[BUFSIZE][MAX_CMD_SIZE];
 // Number of characters read in the current line of serial input
 static int serial_count[NUM_SERIAL] = { 0 };
 
+/**
+ * The line number and checksum of each serial line are gathered
+ * as characters are stored, so the line isn't scanned again.
+ */
+typedef struct {
+  long N;             // Value of the leading N, if any
+  int star;           // Position of the last '*', or -1
+  uint8_t sum,        // XOR of the line so far
+          star_sum;   // XOR of the line before the last '*'
+  bool in_N;          // Reading the digits of the leading N
+} line_check_t;
+
+static line_check_t line_check[NUM_SERIAL];
+
+#if ENABLED(CREDIT_FLOW_CONTROL)
+  bool GCodeQueue::credit_flow[NUM_SERIAL];
+  static uint16_t credit_due[NUM_SERIAL]; // Bytes read since the last credit was sent
+
+  void GCodeQueue::set_credit_flow(const uint8_t pn, const bool onoff) {
+    credit_flow[pn] = onoff;
+    credit_due[pn] = 0;
+  }
+
+  // Return credit to the host for the bytes read so far
+  inline void send_credit(const uint8_t pn) {
+    PORT_REDIRECT(pn);
+    SERIAL_ECHOPGM(STR_OK);
+    SERIAL_ECHOLNPAIR(" C", credit_due[pn]);
+    credit_due[pn] = 0;
+  }
+#endif
+
+#ifdef SERIAL_RESEND_WINDOW
+  /**
+   * After a resend request, valid lines that follow the bad one are held
+   * here (by line number) until the missing line arrives. Copies that the
+   * host sends again are acknowledged without being queued twice.
+   */
+  static bool resyncing; // A resend was requested and lines may come twice
+  static uint16_t held;  // Bits for the slots in use
+  static char held_line[SERIAL_RESEND_WINDOW][MAX_CMD_SIZE];
+  static long held_N[SERIAL_RESEND_WINDOW];
+  #if NUM_SERIAL > 1
+    static uint8_t held_port[SERIAL_RESEND_WINDOW];
+  #endif
+  #define HELD_SLOT(N) uint8_t((N) % (SERIAL_RESEND_WINDOW))
+#endif
+
 bool send_ok[BUFSIZE];
 
 /**
@@ -109,12 +179,40 @@ bool GCodeQueue::has_commands_queued() {
  */
 void GCodeQueue::clear() {
   index_r = index_w = length = 0;
+  buffer_w = 0;
+  #if NUM_SERIAL > 1
+    ZERO(port_length);
+  #endif
+}
+
+/**
+ * Check whether a command of 'size' bytes (including the terminator) fits.
+ * Each command is stored contiguously. When there's no room at the end of
+ * the buffer the command goes to the start, if the oldest command is not
+ * in the way. The write position never catches up to the oldest command.
+ */
+bool GCodeQueue::has_space(const uint16_t size/*=MAX_CMD_SIZE*/) {
+  if (length >= BUFSIZE) return false;
+  if (!length) return true;
+  const uint16_t buffer_r = command_pos[index_r];
+  if (buffer_w < buffer_r) return buffer_r - buffer_w > size;
+  return COMMAND_BUFFER_SIZE - buffer_w >= size || buffer_r > size;
+}
+
+/**
+ * Get the place to write a command of 'size' bytes, wrapping around to
+ * the start of the buffer if needed. Call only if has_space(size).
+ */
+char* GCodeQueue::write_pos(const uint16_t size) {
+  if (!length || (buffer_w >= command_pos[index_r] && COMMAND_BUFFER_SIZE - buffer_w < size))
+    buffer_w = 0;
+  return &command_buffer[buffer_w];
 }
 
 /**
  * Once a new command is in the ring buffer, call this to commit it
  */
-void GCodeQueue::_commit_command(bool say_ok
+void GCodeQueue::_commit_command(const uint16_t size, bool say_ok
   #if NUM_SERIAL > 1
     , int16_t p/*=-1*/
   #endif
@@ -122,10 +220,37 @@ void GCodeQueue::_commit_command(bool say_ok
   send_ok[index_w] = say_ok;
   #if NUM_SERIAL > 1
     port[index_w] = p;
+    if (p >= 0) {
+      port_length[p]++;
+      #if ENABLED(SERIAL_PORT_STATS)
+        NOLESS(port_stats[p].max_queued, port_length[p]);
+      #endif
+    }
+  #elif ENABLED(SERIAL_PORT_STATS)
+    if (say_ok) NOLESS(port_stats[0].max_queued, length + 1);
   #endif
   #if ENABLED(POWER_LOSS_RECOVERY)
     recovery.commit_sdpos(index_w);
   #endif
+  command_pos[index_w] = buffer_w;
+  #if ENABLED(PREPARSE_GCODE)
+    #if ENABLED(SDSUPPORT)
+      // Lines being written to SD, or queued behind an M28 that will write
+      // them, are kept exactly as received. They're parsed if they run.
+      static bool save_pending;
+      if (!length) save_pending = false;              // Any M28 has run
+      if (card.flag.saving || save_pending)
+        parsed[index_w].command_ptr = nullptr;
+      else
+    #endif
+      {
+        parser.preparse(&command_buffer[buffer_w], parsed[index_w], length);
+        #if ENABLED(SDSUPPORT)
+          save_pending = parsed[index_w].command_letter == 'M' && parsed[index_w].codenum == 28;
+        #endif
+      }
+  #endif
+  buffer_w += size;
   if (++index_w >= BUFSIZE) index_w = 0;
   length++;
 }
@@ -140,9 +265,11 @@ bool GCodeQueue::_enqueue(const char* cmd, bool say_ok/*=false*/
     , int16_t pn/*=-1*/
   #endif
 ) {
-  if (*cmd == ';' || length >= BUFSIZE) return false;
-  strcpy(command_buffer[index_w], cmd);
-  _commit_command(say_ok
+  if (*cmd == ';') return false;
+  const uint16_t size = strlen(cmd) + 1;
+  if (!has_space(size)) return false;
+  strcpy(write_pos(size), cmd);
+  _commit_command(size, say_ok
     #if NUM_SERIAL > 1
       , pn
     #endif
@@ -263,7 +390,7 @@ void GCodeQueue::ok_to_send() {
   if (!send_ok[index_r]) return;
   SERIAL_ECHOPGM(STR_OK);
   #if ENABLED(ADVANCED_OK)
-    char* p = command_buffer[index_r];
+    char* p = command(index_r);
     if (*p == 'N') {
       SERIAL_ECHO(' ');
       SERIAL_ECHO(*p++);
@@ -301,6 +428,16 @@ inline bool serial_data_available() {
   ;
 }
 
+// Is there input on a port that has room for more commands?
+inline bool serial_input_ready() {
+  return false
+    || (PORT_HAS_ROOM(0) && MYSERIAL0.available())
+    #if NUM_SERIAL > 1
+      || (PORT_HAS_ROOM(1) && MYSERIAL1.available())
+    #endif
+  ;
+}
+
 inline int read_serial(const uint8_t index) {
   switch (index) {
     case 0: return MYSERIAL0.read();
@@ -313,14 +450,66 @@ inline int read_serial(const uint8_t index) {
 
 void GCodeQueue::gcode_line_error(PGM_P const err, const int8_t pn) {
   PORT_REDIRECT(pn);                      // Reply to the serial port that sent the command
+  #if ENABLED(SERIAL_PORT_STATS)
+    port_stats[pn].errors++;
+  #endif
   SERIAL_ERROR_START();
   serialprintPGM(err);
   SERIAL_ECHOLN(last_N);
-  while (read_serial(pn) != -1);          // Clear out the RX buffer
+  #ifdef SERIAL_RESEND_WINDOW
+    resyncing = true;                     // Keep later lines to use after the resend
+  #else
+    while (read_serial(pn) != -1);        // Clear out the RX buffer
+  #endif
+  #if ENABLED(CREDIT_FLOW_CONTROL)
+    credit_due[pn] = 0;                   // The resend returns all credit
+  #endif
   flush_and_request_resend();
   serial_count[pn] = 0;
 }
 
+#ifdef SERIAL_RESEND_WINDOW
+
+  /**
+   * While resyncing, acknowledge a valid line that was already queued or
+   * that can be held for later. Return false to treat it as an error.
+   */
+  bool GCodeQueue::hold_resent_line(const char * const cmd, const long N, const uint8_t pn) {
+    if (!resyncing) return false;
+    if (N > last_N) {
+      if (N - last_N > SERIAL_RESEND_WINDOW) return false;
+      const uint8_t slot = HELD_SLOT(N);
+      strcpy(held_line[slot], cmd);
+      held_N[slot] = N;
+      SBI(held, slot);
+      #if NUM_SERIAL > 1
+        held_port[slot] = pn;
+      #endif
+    }
+    PORT_REDIRECT(pn);
+    SERIAL_ECHOLNPGM(STR_OK);
+    return true;
+  }
+
+  /**
+   * Queue held lines that now follow the last line received,
+   * as far as the queue has room for them.
+   */
+  void GCodeQueue::release_held_lines() {
+    for (;;) {
+      const uint8_t slot = HELD_SLOT(last_N + 1);
+      if (!TEST(held, slot) || held_N[slot] != last_N + 1 || !_enqueue(held_line[slot], false
+        #if NUM_SERIAL > 1
+          , held_port[slot]
+        #endif
+      )) break;
+      CBI(held, slot);
+      last_N++;
+    }
+  }
+
+#endif // SERIAL_RESEND_WINDOW
+
 FORCE_INLINE bool is_M29(const char * const cmd) {  // matches "M29" & "M29 ", but not "M290", etc
   const char * const m29 = strstr_P(cmd, PSTR("M29"));
   return m29 && !NUMERIC(m29[3]);
@@ -332,7 +521,7 @@ FORCE_INLINE bool is_M29(const char * const cmd) {  // matches "M29" & "M29 ", b
 #define PS_PAREN  3
 #define PS_ESC    4
 
-inline void process_stream_char(const char c, uint8_t &sis, char (&buff)[MAX_CMD_SIZE], int &ind) {
+inline void process_stream_char(const char c, uint8_t &sis, char * const buff, int &ind) {
 
   if (sis == PS_EOL) return;    // EOL comment or overflow
 
@@ -378,11 +567,28 @@ inline void process_stream_char(const char c, uint8_t &sis, char (&buff)[MAX_CMD
     sis = PS_EOL;               // Skip the rest on overflow
 }
 
+/**
+ * Update the line number and checksum for a character stored at 'ind'
+ */
+inline void line_check_char(line_check_t &lc, const char c, const int ind) {
+  if (ind == 0) {
+    lc.sum = 0;
+    lc.star = -1;
+    lc.N = 0;
+    lc.in_N = (c == 'N');
+  }
+  else if (lc.in_N) {
+    if (NUMERIC(c)) lc.N = lc.N * 10 + (c - '0'); else lc.in_N = false;
+  }
+  if (c == '*') { lc.star = ind; lc.star_sum = lc.sum; }
+  lc.sum ^= c;
+}
+
 /**
  * Handle a line being completed. For an empty line
  * keep sensor readings going and watchdog alive.
  */
-inline bool process_line_done(uint8_t &sis, char (&buff)[MAX_CMD_SIZE], int &ind) {
+inline bool process_line_done(uint8_t &sis, char * const buff, int &ind) {
   sis = PS_NORMAL;
   buff[ind] = 0;
   if (ind) { ind = 0; return false; }
@@ -404,10 +610,15 @@ void GCodeQueue::get_serial_commands() {
     if (card.flag.binary_mode) {
       /**
        * For binary stream file transfer, use serial_line_buffer as the working
-       * receive buffer (which limits the packet size to MAX_CMD_SIZE).
+       * receive buffer (which limits the packet size to MAX_CMD_SIZE), unless
+       * BINARY_STREAM_WINDOW provides a window of larger buffers.
        * The receive buffer also limits the packet size for reliable transmission.
        */
-      binaryStream[card.transfer_port_index].receive(serial_line_buffer[card.transfer_port_index]);
+      #if ENABLED(BINARY_STREAM_WINDOW)
+        binaryStream[card.transfer_port_index].receive(BinaryStream::packet_buffer);
+      #else
+        binaryStream[card.transfer_port_index].receive(serial_line_buffer[card.transfer_port_index]);
+      #endif
       return;
     }
   #endif
@@ -423,15 +634,29 @@ void GCodeQueue::get_serial_commands() {
     }
   #endif
 
+  #ifdef SERIAL_RESEND_WINDOW
+    release_held_lines();
+  #endif
+
   /**
    * Loop while serial characters are incoming and the queue is not full
    */
-  while (length < BUFSIZE && serial_data_available()) {
+  while (has_space() && serial_input_ready()) {
     LOOP_L_N(i, NUM_SERIAL) {
 
+      if (!PORT_HAS_ROOM(i)) continue;                      // Leave input for later
+
       const int c = read_serial(i);
       if (c < 0) continue;
 
+      #if ENABLED(SERIAL_PORT_STATS)
+        port_stats[i].bytes++;
+      #endif
+
+      #if ENABLED(CREDIT_FLOW_CONTROL)
+        if (credit_flow[i] && ++credit_due[i] >= (CREDIT_FLOW_WINDOW) / 2) send_credit(i);
+      #endif
+
       const char serial_char = c;
 
       if (ISEOL(serial_char)) {
@@ -440,36 +665,43 @@ void GCodeQueue::get_serial_commands() {
         if (process_line_done(serial_input_state[i], serial_line_buffer[i], serial_count[i]))
           continue;
 
-        char* command = serial_line_buffer[i];
-
-        while (*command == ' ') command++;                   // Skip leading spaces
-        char *npos = (*command == 'N') ? command : nullptr;  // Require the N parameter to start the line
+        char* command = serial_line_buffer[i];               // Leading spaces are not stored
+        const line_check_t &lc = line_check[i];
 
-        if (npos) {
+        if (*command == 'N') {                               // Require the N parameter to start the line
 
-          bool M110 = strstr_P(command, PSTR("M110")) != nullptr;
+          const bool M110 = strstr_P(command, PSTR("M110")) != nullptr;
 
+          gcode_N = lc.N;
           if (M110) {
             char* n2pos = strchr(command + 4, 'N');
-            if (n2pos) npos = n2pos;
+            if (n2pos) gcode_N = strtol(n2pos + 1, nullptr, 10);
           }
 
-          gcode_N = strtol(npos + 1, nullptr, 10);
+          if (lc.star < 0)
+            return gcode_line_error(PSTR(STR_ERR_NO_CHECKSUM), i);
+
+          const bool sum_ok = strtol(command + lc.star + 1, nullptr, 10) == lc.star_sum;
 
-          if (gcode_N != last_N + 1 && !M110)
+          if (gcode_N != last_N + 1 && !M110) {
+            #ifdef SERIAL_RESEND_WINDOW
+              if (sum_ok && hold_resent_line(command, gcode_N, i)) continue;
+            #endif
             return gcode_line_error(PSTR(STR_ERR_LINE_NO), i);
-
-          char *apos = strrchr(command, '*');
-          if (apos) {
-            uint8_t checksum = 0, count = uint8_t(apos - command);
-            while (count) checksum ^= command[--count];
-            if (strtol(apos + 1, nullptr, 10) != checksum)
-              return gcode_line_error(PSTR(STR_ERR_CHECKSUM_MISMATCH), i);
           }
-          else
-            return gcode_line_error(PSTR(STR_ERR_NO_CHECKSUM), i);
+
+          if (!sum_ok)
+            return gcode_line_error(PSTR(STR_ERR_CHECKSUM_MISMATCH), i);
 
           last_N = gcode_N;
+
+          #ifdef SERIAL_RESEND_WINDOW
+            // Resync is over when no lines are held and no copies are due
+            const uint8_t slot = HELD_SLOT(gcode_N);
+            if (M110) held = 0;
+            else if (held_N[slot] == gcode_N) CBI(held, slot);
+            if (!held) resyncing = false;
+          #endif
         }
         #if ENABLED(SDSUPPORT)
           // Pronterface "M29" and "M29 " has no line number
@@ -516,22 +748,81 @@ void GCodeQueue::get_serial_commands() {
           last_command_time = ms;
         #endif
 
+        #if ENABLED(SERIAL_PORT_STATS)
+          port_stats[i].lines++;
+        #endif
+
         // Add the command to the queue
-        _enqueue(serial_line_buffer[i], true
+        _enqueue(serial_line_buffer[i]
+          #if ENABLED(CREDIT_FLOW_CONTROL)
+            , !credit_flow[i]                                // Acknowledged by credit instead
+          #else
+            , true
+          #endif
           #if NUM_SERIAL > 1
             , i
           #endif
         );
+
+        #ifdef SERIAL_RESEND_WINDOW
+          release_held_lines();
+        #endif
       }
-      else
+      else {
+        const int ind = serial_count[i];
+        if (!ind && serial_char == ' ') continue;            // Skip leading spaces
         process_stream_char(serial_char, serial_input_state[i], serial_line_buffer[i], serial_count[i]);
+        if (serial_count[i] > ind) line_check_char(line_check[i], serial_char, ind);
+      }
 
     } // for NUM_SERIAL
   } // queue has space, serial has data
+
+  #if ENABLED(CREDIT_FLOW_CONTROL)
+    // Return credit once the host pauses, so it never waits on a partial batch
+    LOOP_L_N(i, NUM_SERIAL) if (credit_flow[i] && credit_due[i] && !serial_data_available()) send_credit(i);
+  #endif
 }
 
 #if ENABLED(SDSUPPORT)
 
+  #if ENABLED(SD_READ_AHEAD)
+
+    // Find the end of a line in a block of the file
+    inline const char* find_eol(const char * const data, const uint16_t len) {
+      const char * const nl = (const char*)memchr(data, '\n', len);
+      const char * const cr = (const char*)memchr(data, '\r', nl ? nl - data : len);
+      return cr ? cr : nl;
+    }
+
+    /**
+     * Add a run of characters, with no EOL, to the command. If there's no
+     * escape, quote, or inline comment before a ';' they can't change the
+     * stream state, so copy them in one go and drop any comment unread.
+     */
+    inline void process_stream_chars(const char * const data, const uint16_t len, uint8_t &sis, char * const buff, int &ind) {
+      if (sis == PS_EOL) return;                          // EOL comment or overflow
+      const char * const semi = (const char*)memchr(data, ';', len);
+      const uint16_t count = semi ? semi - data : len;
+      if (sis == PS_NORMAL && !memchr(data, '\\', count)
+        #if ENABLED(GCODE_QUOTED_STRINGS)
+          && !memchr(data, '"', count)
+        #endif
+        #if ENABLED(PAREN_COMMENTS)
+          && !memchr(data, '(', count)
+        #endif
+      ) {
+        const uint16_t room = MAX_CMD_SIZE - 1 - ind, n = _MIN(count, room);
+        memcpy(&buff[ind], data, n);
+        ind += n;
+        if (semi || count >= room) sis = PS_EOL;          // Skip the comment, or the rest on overflow
+      }
+      else
+        for (uint16_t i = 0; i < len; i++) process_stream_char(data[i], sis, buff, ind);
+    }
+
+  #endif
+
   /**
    * Get lines from the SD Card until the command buffer is full
    * or until the end of the file is reached. Because this method
@@ -545,19 +836,46 @@ void GCodeQueue::get_serial_commands() {
 
     int sd_count = 0;
     bool card_eof = card.eof();
-    while (length < BUFSIZE && !card_eof) {
-      const int16_t n = card.get();
-      card_eof = card.eof();
-      if (n < 0 && !card_eof) { SERIAL_ERROR_MSG(STR_SD_ERR_READ); continue; }
+    while (has_space() && !card_eof) {
+      #if ENABLED(SD_READ_AHEAD)
+
+        // Take the rest of the line from the read-ahead block, or all of the block
+        const char *data;
+        const uint16_t avail = card.peek(data);
+        card_eof = card.eof();
+        if (!avail && !card_eof) { SERIAL_ERROR_MSG(STR_SD_ERR_READ); continue; }
+
+        // SD lines are read straight into the queue
+        char * const sd_command = write_pos(MAX_CMD_SIZE);
+
+        const char * const eol = avail ? find_eol(data, avail) : nullptr;
+        const bool is_eol = eol != nullptr;
+        if (avail) {
+          const uint16_t len = is_eol ? eol - data : avail;
+          process_stream_chars(data, len, sd_input_state, sd_command, sd_count);
+          card.skip(len + is_eol);
+        }
+
+      #else
+
+        const int16_t n = card.get();
+        card_eof = card.eof();
+        if (n < 0 && !card_eof) { SERIAL_ERROR_MSG(STR_SD_ERR_READ); continue; }
+
+        // SD lines are read straight into the queue
+        char * const sd_command = write_pos(MAX_CMD_SIZE);
+
+        const char sd_char = (char)n;
+        const bool is_eol = ISEOL(sd_char);
+
+      #endif
 
-      const char sd_char = (char)n;
-      const bool is_eol = ISEOL(sd_char);
       if (is_eol || card_eof) {
 
         // Reset stream state, terminate the buffer, and commit a non-empty command
-        if (!is_eol && sd_count) ++sd_count;          // End of file with no newline
-        if (!process_line_done(sd_input_state, command_buffer[index_w], sd_count)) {
-          _commit_command(false);
+        const uint16_t size = sd_count + 1;
+        if (!process_line_done(sd_input_state, sd_command, sd_count)) {
+          _commit_command(size, false);
           #if ENABLED(POWER_LOSS_RECOVERY)
             recovery.cmd_sdpos = card.getIndex();     // Prime for the NEXT _commit_command
           #endif
@@ -565,10 +883,16 @@ void GCodeQueue::get_serial_commands() {
 
         if (card_eof) card.fileHasFinished();         // Handle end of file reached
       }
-      else
-        process_stream_char(sd_char, sd_input_state, command_buffer[index_w], sd_count);
+      #if DISABLED(SD_READ_AHEAD)
+        else
+          process_stream_char(sd_char, sd_input_state, sd_command, sd_count);
+      #endif
 
     }
+
+    #if ENABLED(SD_READ_AHEAD)
+      if (!card_eof) card.read_ahead();               // The queue is full, so read ahead
+    #endif
   }
 
 #endif // SDSUPPORT
@@ -599,10 +923,14 @@ void GCodeQueue::advance() {
   // Return if the G-code buffer is empty
   if (!length) return;
 
+  #if NUM_SERIAL > 1
+    const int16_t pn = port[index_r];
+  #endif
+
   #if ENABLED(SDSUPPORT)
 
     if (card.flag.saving) {
-      char* command = command_buffer[index_r];
+      char* command = GCodeQueue::command(index_r);
       if (is_M29(command)) {
         // M29 closes the file
         card.closefile();
@@ -642,4 +970,8 @@ void GCodeQueue::advance() {
   --length;
   if (++index_r >= BUFSIZE) index_r = 0;
 
+  #if NUM_SERIAL > 1
+    if (pn >= 0 && port_length[pn]) port_length[pn]--;
+  #endif
+
 }
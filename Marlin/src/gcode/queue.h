@@ -28,6 +28,10 @@
 
 #include "../inc/MarlinConfig.h"
 
+#if ENABLED(PREPARSE_GCODE)
+  #include "parser.h"
+#endif
+
 class GCodeQueue {
 public:
   /**
@@ -39,7 +43,8 @@ public:
 
   /**
    * GCode Command Queue
-   * A simple ring buffer of BUFSIZE command strings.
+   * A ring buffer of up to BUFSIZE command strings, packed end-to-end
+   * into COMMAND_BUFFER_SIZE bytes so short commands take less room.
    *
    * Commands are copied into this buffer by the command injectors
    * (immediate, serial, sd card) and they are processed sequentially by
@@ -49,7 +54,40 @@ public:
   static uint8_t length,  // Count of commands in the queue
                  index_r; // Ring buffer read position
 
-  static char command_buffer[BUFSIZE][MAX_CMD_SIZE];
+  static char command_buffer[COMMAND_BUFFER_SIZE];  // Null-terminated commands, packed end-to-end
+  static uint16_t command_pos[BUFSIZE];             // Start of each command in command_buffer
+
+  /**
+   * Get the command at the given ring buffer position
+   */
+  FORCE_INLINE static char* command(const uint8_t index) { return &command_buffer[command_pos[index]]; }
+
+  #if ENABLED(PREPARSE_GCODE)
+    /**
+     * Commands are parsed as they enter the queue. A null command_ptr
+     * means the command was queued unparsed, to be parsed when it runs.
+     */
+    static GCodeParser::parsed_command_t parsed[BUFSIZE];
+  #endif
+
+  #if ENABLED(SERIAL_PORT_STATS)
+    /**
+     * Statistics for each serial port (M577)
+     */
+    typedef struct {
+      uint32_t bytes, lines, errors;
+      uint8_t max_queued;
+    } port_stats_t;
+    static port_stats_t port_stats[NUM_SERIAL];
+  #endif
+
+  #if ENABLED(CREDIT_FLOW_CONTROL)
+    /**
+     * Serial ports using credit-based flow control (M576)
+     */
+    static bool credit_flow[NUM_SERIAL];
+    static void set_credit_flow(const uint8_t pn, const bool onoff);
+  #endif
 
   /*
    * The port that the command was received on
@@ -88,11 +126,30 @@ public:
    */
   static void enqueue_now_P(PGM_P const cmd);
 
+  /**
+   * Attempt to enqueue a single line from a stream on the given
+   * port that is acknowledged separately. Return 'true' if successful.
+   */
+  FORCE_INLINE static bool enqueue_line(const char* cmd, const int16_t pn) {
+    #if NUM_SERIAL > 1
+      return _enqueue(cmd, false, pn);
+    #else
+      UNUSED(pn);
+      return _enqueue(cmd);
+    #endif
+  }
+
   /**
    * Check whether there are any commands yet to be executed
    */
   static bool has_commands_queued();
 
+  /**
+   * Check whether a command of 'size' bytes, including the
+   * terminator, can be added to the queue
+   */
+  static bool has_space(const uint16_t size=MAX_CMD_SIZE);
+
   /**
    * Get the next command in the queue, optionally log it to SD, then dispatch it
    */
@@ -127,13 +184,17 @@ private:
 
   static uint8_t index_w;  // Ring buffer write position
 
+  static uint16_t buffer_w; // Write position in command_buffer
+
+  static char* write_pos(const uint16_t size);
+
   static void get_serial_commands();
 
   #if ENABLED(SDSUPPORT)
     static void get_sdcard_commands();
   #endif
 
-  static void _commit_command(bool say_ok
+  static void _commit_command(const uint16_t size, bool say_ok
     #if NUM_SERIAL > 1
       , int16_t p=-1
     #endif
@@ -156,6 +217,11 @@ private:
 
   static void gcode_line_error(PGM_P const err, const int8_t pn);
 
+  #ifdef SERIAL_RESEND_WINDOW
+    static bool hold_resent_line(const char * const cmd, const long N, const uint8_t pn);
+    static void release_held_lines();
+  #endif
+
 };
 
 extern GCodeQueue queue;
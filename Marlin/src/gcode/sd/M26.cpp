@@ -29,10 +29,34 @@
 
 /**
  * M26: Set SD Card file index
+ *
+ *  S<byte>   Position in bytes
+ *
+ * With SD_LINE_INDEX:
+ *  N<line>   Start of a line, counting from 1
+ *  L<layer>  Start of a layer, counting ";LAYER:" or ";LAYER_CHANGE" comments from 0.
+ *            The number in the comment is ignored, so raft layers are counted too.
+ *
+ * With none of these, report the line and layer at the current position.
  */
 void GcodeSuite::M26() {
-  if (card.isMounted() && parser.seenval('S'))
+  if (!card.isMounted()) return;
+
+  if (parser.seenval('S'))
     card.setIndex(parser.value_long());
+
+  #if ENABLED(SD_LINE_INDEX)
+    else if (card.isFileOpen()) {
+      bool found = true;
+      if (parser.seenval('N'))
+        found = card.seekLine(parser.value_ulong());
+      else if (parser.seenval('L'))
+        found = card.seekLayer(parser.value_ulong());
+      else
+        card.report_line();
+      if (!found) SERIAL_ERROR_MSG(STR_SD_LINE_NOT_FOUND);
+    }
+  #endif
 }
 
 #endif // SDSUPPORT
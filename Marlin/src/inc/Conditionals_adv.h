@@ -290,3 +290,18 @@
     #define MAXIMUM_STEPPER_RATE 250000
   #endif
 #endif
+
+// Size of the packed command queue text buffer
+#ifndef COMMAND_BUFFER_SIZE
+  #define COMMAND_BUFFER_SIZE ((BUFSIZE) * (MAX_CMD_SIZE))
+#endif
+
+// Binary mode otherwise receives one packet at a time into a serial line buffer
+#if ENABLED(BINARY_FILE_TRANSFER) && DISABLED(BINARY_STREAM_WINDOW)
+  #define BINARY_STREAM_WINDOW_PACKETS 1
+  #define BINARY_STREAM_PACKET_SIZE MAX_CMD_SIZE
+#endif
+
+#if ENABLED(GCODE_MACROS) && !defined(GCODE_MACROS_SLOT_COMMANDS)
+  #define GCODE_MACROS_SLOT_COMMANDS 5
+#endif
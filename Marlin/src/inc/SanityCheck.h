@@ -661,6 +661,36 @@ static_assert(Y_MAX_LENGTH >= Y_BED_SIZE, "Movement bounds (Y_MIN_POS, Y_MAX_POS
   #error "LIGHTWEIGHT_UI requires a U8GLIB_ST7920-based display."
 #endif
 
+/**
+ * SD Read-Ahead, Extent Map, Write-Behind, Directory and Line Indexes
+ */
+#if ENABLED(SD_READ_AHEAD) && !WITHIN(SD_READ_AHEAD_BLOCKS, 1, 8)
+  #error "SD_READ_AHEAD_BLOCKS must be from 1 to 8."
+#endif
+#if ENABLED(SD_EXTENT_MAP) && !WITHIN(SD_EXTENT_MAP_SIZE, 1, 255)
+  #error "SD_EXTENT_MAP_SIZE must be from 1 to 255."
+#endif
+#if ENABLED(SD_WRITE_BEHIND) && !WITHIN(SD_WRITE_BEHIND_BLOCKS, 1, 8)
+  #error "SD_WRITE_BEHIND_BLOCKS must be from 1 to 8."
+#endif
+#if ENABLED(SD_DIR_INDEX) && !WITHIN(SD_DIR_INDEX_SIZE, 1, 4096)
+  #error "SD_DIR_INDEX_SIZE must be from 1 to 4096."
+#endif
+#if ENABLED(SD_LINE_INDEX) && !WITHIN(SD_LINE_INDEX_SIZE, 2, 255)
+  #error "SD_LINE_INDEX_SIZE must be from 2 to 255."
+#endif
+
+/**
+ * Binary Stream Window
+ */
+#if ENABLED(BINARY_STREAM_WINDOW)
+  #if BINARY_STREAM_WINDOW_PACKETS != 1 && BINARY_STREAM_WINDOW_PACKETS != 2 && BINARY_STREAM_WINDOW_PACKETS != 4 && BINARY_STREAM_WINDOW_PACKETS != 8
+    #error "BINARY_STREAM_WINDOW_PACKETS must be 1, 2, 4, or 8."
+  #elif !WITHIN(BINARY_STREAM_PACKET_SIZE, MAX_CMD_SIZE, 4096)
+    #error "BINARY_STREAM_PACKET_SIZE must be from MAX_CMD_SIZE to 4096."
+  #endif
+#endif
+
 /**
  * SD File Sorting
  */
@@ -1934,6 +1964,43 @@ static_assert(Y_MAX_LENGTH >= Y_BED_SIZE, "Movement bounds (Y_MIN_POS, Y_MAX_POS
 
 #if defined(ENDSTOP_NOISE_THRESHOLD) && !WITHIN(ENDSTOP_NOISE_THRESHOLD, 2, 7)
   #error "ENDSTOP_NOISE_THRESHOLD must be an integer from 2 to 7."
+#elif ENDSTOP_NOISE_THRESHOLD && ENABLED(ENDSTOP_BLOCK_MASK)
+  #error "ENDSTOP_BLOCK_MASK is incompatible with ENDSTOP_NOISE_THRESHOLD."
+#endif
+
+/**
+ * Command queue
+ */
+#if ENABLED(PREPARSE_GCODE) && DISABLED(FASTER_GCODE_PARSER)
+  #error "PREPARSE_GCODE requires FASTER_GCODE_PARSER."
+#endif
+#if defined(SERIAL_RESEND_WINDOW) && !WITHIN(SERIAL_RESEND_WINDOW, 1, 16)
+  #error "SERIAL_RESEND_WINDOW must be from 1 to 16."
+#endif
+#if defined(SERIAL_TX_BATCH) && !WITHIN(SERIAL_TX_BATCH, 8, 255)
+  #error "SERIAL_TX_BATCH must be from 8 to 255."
+#endif
+#if ENABLED(GCODE_PROFILER) && !WITHIN(GCODE_PROFILER_SLOTS, 2, 255)
+  #error "GCODE_PROFILER_SLOTS must be from 2 to 255."
+#endif
+#if defined(SERIAL_QUEUE_LIMITS) && NUM_SERIAL < 2
+  #error "SERIAL_QUEUE_LIMITS requires SERIAL_PORT_2."
+#endif
+#if ENABLED(CREDIT_FLOW_CONTROL)
+  #if defined(SERIAL_RESEND_WINDOW)
+    #error "CREDIT_FLOW_CONTROL is not compatible with SERIAL_RESEND_WINDOW."
+  #elif !WITHIN(CREDIT_FLOW_WINDOW, 16, 65535)
+    #error "CREDIT_FLOW_WINDOW must be from 16 to 65535."
+  #elif defined(RX_BUFFER_SIZE) && RX_BUFFER_SIZE && CREDIT_FLOW_WINDOW >= RX_BUFFER_SIZE
+    #error "CREDIT_FLOW_WINDOW must be smaller than RX_BUFFER_SIZE."
+  #endif
+#endif
+#if BUFSIZE > 255
+  #error "BUFSIZE must be 255 or less."
+#elif COMMAND_BUFFER_SIZE < MAX_CMD_SIZE
+  #error "COMMAND_BUFFER_SIZE must be at least MAX_CMD_SIZE."
+#elif COMMAND_BUFFER_SIZE > 65535
+  #error "COMMAND_BUFFER_SIZE must be 65535 or less."
 #endif
 
 /**
@@ -2526,6 +2593,9 @@ static_assert(   _ARR_TEST(3,0) && _ARR_TEST(3,1) && _ARR_TEST(3,2)
 #if ENABLED(BACKUP_POWER_SUPPLY) && !PIN_EXISTS(POWER_LOSS)
   #error "BACKUP_POWER_SUPPLY requires a POWER_LOSS_PIN."
 #endif
+#if ENABLED(POWER_LOSS_JOURNAL) && !WITHIN(POWER_LOSS_JOURNAL_BLOCKS, 2, 255)
+  #error "POWER_LOSS_JOURNAL_BLOCKS must be from 2 to 255."
+#endif
 
 #if ENABLED(Z_STEPPER_AUTO_ALIGN)
   #if NUM_Z_STEPPER_DRIVERS <= 1
@@ -2551,6 +2621,10 @@ static_assert(   _ARR_TEST(3,0) && _ARR_TEST(3,1) && _ARR_TEST(3,2)
 
 #if ENABLED(GCODE_MACROS) && !WITHIN(GCODE_MACROS_SLOTS, 1, 10)
   #error "GCODE_MACROS_SLOTS must be a number from 1 to 10."
+#elif BOTH(PREPARSE_GCODE, GCODE_MACROS) && !WITHIN(GCODE_MACROS_SLOT_COMMANDS, 1, 25)
+  #error "GCODE_MACROS_SLOT_COMMANDS must be a number from 1 to 25."
+#elif ENABLED(GCODE_MACROS_IN_EEPROM) && DISABLED(EEPROM_SETTINGS)
+  #error "GCODE_MACROS_IN_EEPROM requires EEPROM_SETTINGS."
 #endif
 
 #if ENABLED(CUSTOM_USER_MENUS)
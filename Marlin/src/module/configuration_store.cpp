@@ -96,6 +96,10 @@
   #include "../feature/backlash.h"
 #endif
 
+#if ENABLED(GCODE_MACROS_IN_EEPROM)
+  #include "../feature/macros.h"
+#endif
+
 #if HAS_FILAMENT_SENSOR
   #include "../feature/runout.h"
 #endif
@@ -388,6 +392,13 @@ typedef struct SettingsDataStruct {
     uint8_t case_light_brightness;
   #endif
 
+  //
+  // GCODE_MACROS_IN_EEPROM
+  //
+  #if ENABLED(GCODE_MACROS_IN_EEPROM)
+    char gcode_macros[GCODE_MACROS_SLOTS][GCODE_MACROS_SLOT_SIZE + 2]; // M810-M819
+  #endif
+
 } SettingsData;
 
 //static_assert(sizeof(SettingsData) <= E2END + 1, "EEPROM too small to contain SettingsData!");
@@ -1332,6 +1343,14 @@ void MarlinSettings::postprocess() {
       EEPROM_WRITE(case_light_brightness);
     #endif
 
+    //
+    // G-code Macros
+    //
+    #if ENABLED(GCODE_MACROS_IN_EEPROM)
+      _FIELD_TEST(gcode_macros);
+      EEPROM_WRITE(macros.text);
+    #endif
+
     //
     // Validate CRC and Data Size
     //
@@ -2194,6 +2213,15 @@ void MarlinSettings::postprocess() {
         EEPROM_READ(case_light_brightness);
       #endif
 
+      //
+      // G-code Macros
+      //
+      #if ENABLED(GCODE_MACROS_IN_EEPROM)
+        _FIELD_TEST(gcode_macros);
+        EEPROM_READ(macros.text);
+        if (!validating) macros.compile_all();
+      #endif
+
       eeprom_error = size_error(eeprom_index - (EEPROM_OFFSET));
       if (eeprom_error) {
         DEBUG_ECHO_START();
@@ -2497,6 +2525,14 @@ void MarlinSettings::reset() {
     case_light_brightness = CASE_LIGHT_DEFAULT_BRIGHTNESS;
   #endif
 
+  //
+  // G-code Macros
+  //
+
+  #if ENABLED(GCODE_MACROS_IN_EEPROM)
+    macros.reset();
+  #endif
+
   //
   // Magnetic Parking Extruder
   //
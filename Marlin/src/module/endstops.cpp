@@ -57,6 +57,10 @@ volatile uint8_t Endstops::hit_state;
 
 Endstops::esbits_t Endstops::live_state = 0;
 
+#if ENABLED(ENDSTOP_BLOCK_MASK)
+  uint8_t Endstops::active_mask; // = 0
+#endif
+
 #if ENDSTOP_NOISE_THRESHOLD
   Endstops::esbits_t Endstops::validated_live_state;
   uint8_t Endstops::endstop_poll_count;
@@ -511,6 +515,47 @@ void _O2 Endstops::report_states() {
 #define _ENDSTOP_PIN(AXIS, MINMAX) AXIS ##_## MINMAX ##_PIN
 #define _ENDSTOP_INVERTING(AXIS, MINMAX) AXIS ##_## MINMAX ##_ENDSTOP_INVERTING
 
+// Use HEAD for core axes, AXIS for others
+#if CORE_IS_XY || CORE_IS_XZ
+  #define X_AXIS_HEAD X_HEAD
+#else
+  #define X_AXIS_HEAD X_AXIS
+#endif
+#if CORE_IS_XY || CORE_IS_YZ
+  #define Y_AXIS_HEAD Y_HEAD
+#else
+  #define Y_AXIS_HEAD Y_AXIS
+#endif
+#if CORE_IS_XZ || CORE_IS_YZ
+  #define Z_AXIS_HEAD Z_HEAD
+#else
+  #define Z_AXIS_HEAD Z_AXIS
+#endif
+
+#if ENABLED(ENDSTOP_BLOCK_MASK)
+
+  // Called by the Planner for each new block
+  uint8_t Endstops::block_mask(const uint8_t axis_bits, const uint8_t direction_bits) {
+    uint8_t mask = 0;
+    if (TEST(axis_bits, X_AXIS)) SBI(mask, TEST(direction_bits, X_AXIS_HEAD) ? X_MIN : X_MAX);
+    if (TEST(axis_bits, Y_AXIS)) SBI(mask, TEST(direction_bits, Y_AXIS_HEAD) ? Y_MIN : Y_MAX);
+    if (TEST(axis_bits, Z_AXIS)) {
+      if (TEST(direction_bits, Z_AXIS_HEAD))
+        mask |= _BV(Z_MIN) | _BV(Z_MIN_PROBE);
+      else
+        SBI(mask, Z_MAX);
+    }
+    return mask;
+  }
+
+  #define ENDSTOP_IS_ACTIVE(ENDSTOP) TEST(active_mask, ENDSTOP)
+
+#else
+
+  #define ENDSTOP_IS_ACTIVE(ENDSTOP) true
+
+#endif
+
 // Check endstops - Could be called from Temperature ISR!
 void Endstops::update() {
 
@@ -536,127 +581,122 @@ void Endstops::update() {
     #define X_MAX_TEST() true
   #endif
 
-  // Use HEAD for core axes, AXIS for others
-  #if CORE_IS_XY || CORE_IS_XZ
-    #define X_AXIS_HEAD X_HEAD
-  #else
-    #define X_AXIS_HEAD X_AXIS
-  #endif
-  #if CORE_IS_XY || CORE_IS_YZ
-    #define Y_AXIS_HEAD Y_HEAD
-  #else
-    #define Y_AXIS_HEAD Y_AXIS
-  #endif
-  #if CORE_IS_XZ || CORE_IS_YZ
-    #define Z_AXIS_HEAD Z_HEAD
-  #else
-    #define Z_AXIS_HEAD Z_AXIS
-  #endif
-
   /**
    * Check and update endstops
    */
   #if HAS_X_MIN && !X_SPI_SENSORLESS
-    UPDATE_ENDSTOP_BIT(X, MIN);
-    #if ENABLED(X_DUAL_ENDSTOPS)
-      #if HAS_X2_MIN
-        UPDATE_ENDSTOP_BIT(X2, MIN);
-      #else
-        COPY_LIVE_STATE(X_MIN, X2_MIN);
+    if (ENDSTOP_IS_ACTIVE(X_MIN)) {
+      UPDATE_ENDSTOP_BIT(X, MIN);
+      #if ENABLED(X_DUAL_ENDSTOPS)
+        #if HAS_X2_MIN
+          UPDATE_ENDSTOP_BIT(X2, MIN);
+        #else
+          COPY_LIVE_STATE(X_MIN, X2_MIN);
+        #endif
       #endif
-    #endif
+    }
   #endif
 
   #if HAS_X_MAX && !X_SPI_SENSORLESS
-    UPDATE_ENDSTOP_BIT(X, MAX);
-    #if ENABLED(X_DUAL_ENDSTOPS)
-      #if HAS_X2_MAX
-        UPDATE_ENDSTOP_BIT(X2, MAX);
-      #else
-        COPY_LIVE_STATE(X_MAX, X2_MAX);
+    if (ENDSTOP_IS_ACTIVE(X_MAX)) {
+      UPDATE_ENDSTOP_BIT(X, MAX);
+      #if ENABLED(X_DUAL_ENDSTOPS)
+        #if HAS_X2_MAX
+          UPDATE_ENDSTOP_BIT(X2, MAX);
+        #else
+          COPY_LIVE_STATE(X_MAX, X2_MAX);
+        #endif
       #endif
-    #endif
+    }
   #endif
 
   #if HAS_Y_MIN && !Y_SPI_SENSORLESS
-    UPDATE_ENDSTOP_BIT(Y, MIN);
-    #if ENABLED(Y_DUAL_ENDSTOPS)
-      #if HAS_Y2_MIN
-        UPDATE_ENDSTOP_BIT(Y2, MIN);
-      #else
-        COPY_LIVE_STATE(Y_MIN, Y2_MIN);
+    if (ENDSTOP_IS_ACTIVE(Y_MIN)) {
+      UPDATE_ENDSTOP_BIT(Y, MIN);
+      #if ENABLED(Y_DUAL_ENDSTOPS)
+        #if HAS_Y2_MIN
+          UPDATE_ENDSTOP_BIT(Y2, MIN);
+        #else
+          COPY_LIVE_STATE(Y_MIN, Y2_MIN);
+        #endif
       #endif
-    #endif
+    }
   #endif
 
   #if HAS_Y_MAX && !Y_SPI_SENSORLESS
-    UPDATE_ENDSTOP_BIT(Y, MAX);
-    #if ENABLED(Y_DUAL_ENDSTOPS)
-      #if HAS_Y2_MAX
-        UPDATE_ENDSTOP_BIT(Y2, MAX);
-      #else
-        COPY_LIVE_STATE(Y_MAX, Y2_MAX);
+    if (ENDSTOP_IS_ACTIVE(Y_MAX)) {
+      UPDATE_ENDSTOP_BIT(Y, MAX);
+      #if ENABLED(Y_DUAL_ENDSTOPS)
+        #if HAS_Y2_MAX
+          UPDATE_ENDSTOP_BIT(Y2, MAX);
+        #else
+          COPY_LIVE_STATE(Y_MAX, Y2_MAX);
+        #endif
       #endif
-    #endif
+    }
   #endif
 
   #if HAS_Z_MIN && !Z_SPI_SENSORLESS
-    UPDATE_ENDSTOP_BIT(Z, MIN);
-    #if ENABLED(Z_MULTI_ENDSTOPS)
-      #if HAS_Z2_MIN
-        UPDATE_ENDSTOP_BIT(Z2, MIN);
-      #else
-        COPY_LIVE_STATE(Z_MIN, Z2_MIN);
-      #endif
-      #if NUM_Z_STEPPER_DRIVERS >= 3
-        #if HAS_Z3_MIN
-          UPDATE_ENDSTOP_BIT(Z3, MIN);
+    if (ENDSTOP_IS_ACTIVE(Z_MIN)) {
+      UPDATE_ENDSTOP_BIT(Z, MIN);
+      #if ENABLED(Z_MULTI_ENDSTOPS)
+        #if HAS_Z2_MIN
+          UPDATE_ENDSTOP_BIT(Z2, MIN);
         #else
-          COPY_LIVE_STATE(Z_MIN, Z3_MIN);
+          COPY_LIVE_STATE(Z_MIN, Z2_MIN);
         #endif
-      #endif
-      #if NUM_Z_STEPPER_DRIVERS >= 4
-        #if HAS_Z4_MIN
-          UPDATE_ENDSTOP_BIT(Z4, MIN);
-        #else
-          COPY_LIVE_STATE(Z_MIN, Z4_MIN);
+        #if NUM_Z_STEPPER_DRIVERS >= 3
+          #if HAS_Z3_MIN
+            UPDATE_ENDSTOP_BIT(Z3, MIN);
+          #else
+            COPY_LIVE_STATE(Z_MIN, Z3_MIN);
+          #endif
+        #endif
+        #if NUM_Z_STEPPER_DRIVERS >= 4
+          #if HAS_Z4_MIN
+            UPDATE_ENDSTOP_BIT(Z4, MIN);
+          #else
+            COPY_LIVE_STATE(Z_MIN, Z4_MIN);
+          #endif
         #endif
       #endif
-    #endif
+    }
   #endif
 
   // When closing the gap check the enabled probe
   #if HAS_CUSTOM_PROBE_PIN
-    UPDATE_ENDSTOP_BIT(Z, MIN_PROBE);
+    if (ENDSTOP_IS_ACTIVE(Z_MIN_PROBE)) UPDATE_ENDSTOP_BIT(Z, MIN_PROBE);
   #endif
 
   #if HAS_Z_MAX && !Z_SPI_SENSORLESS
-    // Check both Z dual endstops
-    #if ENABLED(Z_MULTI_ENDSTOPS)
-      UPDATE_ENDSTOP_BIT(Z, MAX);
-      #if HAS_Z2_MAX
-        UPDATE_ENDSTOP_BIT(Z2, MAX);
-      #else
-        COPY_LIVE_STATE(Z_MAX, Z2_MAX);
-      #endif
-      #if NUM_Z_STEPPER_DRIVERS >= 3
-        #if HAS_Z3_MAX
-          UPDATE_ENDSTOP_BIT(Z3, MAX);
+    if (ENDSTOP_IS_ACTIVE(Z_MAX)) {
+      // Check both Z dual endstops
+      #if ENABLED(Z_MULTI_ENDSTOPS)
+        UPDATE_ENDSTOP_BIT(Z, MAX);
+        #if HAS_Z2_MAX
+          UPDATE_ENDSTOP_BIT(Z2, MAX);
         #else
-          COPY_LIVE_STATE(Z_MAX, Z3_MAX);
+          COPY_LIVE_STATE(Z_MAX, Z2_MAX);
         #endif
-      #endif
-      #if NUM_Z_STEPPER_DRIVERS >= 4
-        #if HAS_Z4_MAX
-          UPDATE_ENDSTOP_BIT(Z4, MAX);
-        #else
-          COPY_LIVE_STATE(Z_MAX, Z4_MAX);
+        #if NUM_Z_STEPPER_DRIVERS >= 3
+          #if HAS_Z3_MAX
+            UPDATE_ENDSTOP_BIT(Z3, MAX);
+          #else
+            COPY_LIVE_STATE(Z_MAX, Z3_MAX);
+          #endif
         #endif
+        #if NUM_Z_STEPPER_DRIVERS >= 4
+          #if HAS_Z4_MAX
+            UPDATE_ENDSTOP_BIT(Z4, MAX);
+          #else
+            COPY_LIVE_STATE(Z_MAX, Z4_MAX);
+          #endif
+        #endif
+      #elif !HAS_CUSTOM_PROBE_PIN || Z_MAX_PIN != Z_MIN_PROBE_PIN
+        // If this pin isn't the bed probe it's the Z endstop
+        UPDATE_ENDSTOP_BIT(Z, MAX);
       #endif
-    #elif !HAS_CUSTOM_PROBE_PIN || Z_MAX_PIN != Z_MIN_PROBE_PIN
-      // If this pin isn't the bed probe it's the Z endstop
-      UPDATE_ENDSTOP_BIT(Z, MAX);
-    #endif
+    }
   #endif
 
   #if ENDSTOP_NOISE_THRESHOLD
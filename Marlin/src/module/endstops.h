@@ -66,6 +66,10 @@ class Endstops {
     static esbits_t live_state;
     static volatile uint8_t hit_state;      // Use X_MIN, Y_MIN, Z_MIN and Z_MIN_PROBE as BIT index
 
+    #if ENABLED(ENDSTOP_BLOCK_MASK)
+      static uint8_t active_mask;           // Endstops the current block can trigger. Set by the Stepper.
+    #endif
+
     #if ENDSTOP_NOISE_THRESHOLD
       static esbits_t validated_live_state;
       static uint8_t endstop_poll_count;    // Countdown from threshold for polling
@@ -104,6 +108,18 @@ class Endstops {
      */
     static void update();
 
+    #if ENABLED(ENDSTOP_BLOCK_MASK)
+      /**
+       * Get the endstops a move can trigger, given the axes that move
+       * and the block direction bits. Uses X_MIN, X_MAX, etc. as BIT
+       * index, standing in for all endstops of that axis and direction.
+       */
+      static uint8_t block_mask(const uint8_t axis_bits, const uint8_t direction_bits);
+
+      // Select the endstops to read in update(). Called when a new block starts.
+      FORCE_INLINE static void set_active_mask(const uint8_t mask) { active_mask = mask; }
+    #endif
+
     /**
      * Get Endstop hit state.
      */
@@ -104,6 +104,10 @@
   #include "../feature/powerloss.h"
 #endif
 
+#if ENABLED(ENDSTOP_BLOCK_MASK)
+  #include "endstops.h"
+#endif
+
 #if HAS_CUTTER
 	#ifdef SPINDLE_VFD
 	#include "../feature/vfd_spindle.h"
@@ -1623,12 +1627,18 @@ float Planner::get_axis_position_mm(const AxisEnum axis) {
  * Block until all buffered steps are executed / cleaned
  */
 void Planner::synchronize() {
+  #if ENABLED(GCODE_PROFILER)
+    const uint32_t start = micros();
+  #endif
   while (
     has_blocks_queued() || cleaning_buffer_counter
     #if ENABLED(EXTERNAL_CLOSED_LOOP_CONTROLLER)
       || (READ(CLOSED_LOOP_ENABLE_PIN) && !READ(CLOSED_LOOP_MOVE_COMPLETE_PIN))
     #endif
   ) idle();
+  #if ENABLED(GCODE_PROFILER)
+    profiler.sync_us += micros() - start;
+  #endif
 }
 
 /**
@@ -1817,6 +1827,11 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
   // Set direction bits
   block->direction_bits = dm;
 
+  #if ENABLED(ENDSTOP_BLOCK_MASK)
+    // Only the endstops in the direction of motion need to be read
+    block->endstop_mask = endstops.block_mask((da ? _BV(X_AXIS) : 0) | (db ? _BV(Y_AXIS) : 0) | (dc ? _BV(Z_AXIS) : 0), dm);
+  #endif
+
   // Number of steps for each axis
   // See http://www.corexy.com/theory.html
   #if CORE_IS_XY
@@ -51,6 +51,10 @@
   #include "../feature/mixing.h"
 #endif
 
+#if ENABLED(GCODE_PROFILER)
+  #include "../feature/profiler.h"
+#endif
+
 #if HAS_CUTTER
 	#ifdef SPINDLE_VFD
 	#include "../feature/vfd_spindle.h"
@@ -144,6 +148,10 @@ typedef struct block_t {
 
   uint8_t direction_bits;                   // The direction bit set for this block (refers to *_DIRECTION_BIT in config.h)
 
+  #if ENABLED(ENDSTOP_BLOCK_MASK)
+    uint8_t endstop_mask;                   // The endstops this block can trigger (See Endstops::block_mask)
+  #endif
+
   // Advance extrusion
   #if ENABLED(LIN_ADVANCE)
     bool use_advance_lead;
@@ -573,7 +581,15 @@ class Planner {
     FORCE_INLINE static block_t* get_next_free_block(uint8_t &next_buffer_head, const uint8_t count=1) {
 
       // Wait until there are enough slots free
-      while (moves_free() < count) { idle(); }
+      #if ENABLED(GCODE_PROFILER)
+        if (moves_free() < count) {
+          const uint32_t start = micros();
+          while (moves_free() < count) { idle(); }
+          profiler.wait_us += micros() - start;
+        }
+      #else
+        while (moves_free() < count) { idle(); }
+      #endif
 
       // Return the first available block
       next_buffer_head = next_block_index(block_buffer_head);
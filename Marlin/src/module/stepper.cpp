@@ -1945,6 +1945,9 @@ uint32_t Stepper::block_phase_isr() {
       // done against the endstop. So, check the limits here: If the movement
       // is against the limits, the block will be marked as to be killed, and
       // on the next call to this ISR, will be discarded.
+      #if ENABLED(ENDSTOP_BLOCK_MASK)
+        endstops.set_active_mask(current_block->endstop_mask);
+      #endif
       endstops.update();
 
       #if ENABLED(Z_LATE_ENABLE)
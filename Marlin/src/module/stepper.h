@@ -525,18 +525,18 @@ class Stepper {
         // In case of high-performance processor, it is able to calculate in real-time
         timer = uint32_t(STEPPER_TIMER_RATE) / step_rate;
       #else
-        constexpr uint32_t min_step_rate = F_CPU / 500000U;
-        NOLESS(step_rate, min_step_rate);
-        step_rate -= min_step_rate; // Correct for minimal speed
+        // Tables are generated at compile time for the configured F_CPU
+        NOLESS(step_rate, speed_lookuptable_min_rate);
+        step_rate -= speed_lookuptable_min_rate; // Correct for minimal speed
         if (step_rate >= (8 * 256)) { // higher step rate
           const uint8_t tmp_step_rate = (step_rate & 0x00FF);
-          const uint16_t table_address = (uint16_t)&speed_lookuptable_fast[(uint8_t)(step_rate >> 8)][0],
+          const uint16_t table_address = (uint16_t)&speed_lookuptable_fast.entry[(uint8_t)(step_rate >> 8)][0],
                          gain = (uint16_t)pgm_read_word(table_address + 2);
           timer = MultiU16X8toH16(tmp_step_rate, gain);
           timer = (uint16_t)pgm_read_word(table_address) - timer;
         }
         else { // lower step rates
-          uint16_t table_address = (uint16_t)&speed_lookuptable_slow[0][0];
+          uint16_t table_address = (uint16_t)&speed_lookuptable_slow.entry[0][0];
           table_address += ((step_rate) >> 1) & 0xFFFC;
           timer = (uint16_t)pgm_read_word(table_address)
                 - (((uint16_t)pgm_read_word(table_address + 2) * (uint8_t)(step_rate & 0x0007)) >> 3);
@@ -3091,8 +3091,12 @@ void Temperature::tick() {
 
     void Temperature::auto_report_temperatures() {
       if (auto_report_temp_interval && ELAPSED(millis(), next_temp_report_ms)) {
-        next_temp_report_ms = millis() + 1000UL * auto_report_temp_interval;
         PORT_REDIRECT(SERIAL_BOTH);
+        #if SERIAL_TX_BATCH
+          // Defer to a later idle() rather than stall on a congested TX buffer
+          if (!serial_tx_room(32)) return;
+        #endif
+        next_temp_report_ms = millis() + 1000UL * auto_report_temp_interval;
         print_heater_states(active_extruder);
         SERIAL_EOL();
       }
@@ -1027,6 +1027,18 @@ int16_t SdBaseFile::read(void* buf, uint16_t nbyte) {
     // amount to be read from current block
     NOMORE(n, 512 - offset);
 
+    #if USE_MULTI_BLOCK_IO
+      // read a run of whole blocks in one transfer
+      uint16_t count;
+      if (offset == 0 && toRead >= 1024 && type_ != FAT_FILE_TYPE_ROOT_FIXED && (count = contiguousBlocks(toRead >> 9)) > 1) {
+        // the cache may hold a newer copy of a block in the run
+        const uint32_t cb = vol_->cacheBlockNumber();
+        if (cb >= block && cb < block + count && !vol_->cacheFlush()) return -1;
+        if (!vol_->readBlocks(block, dst, count)) return -1;
+        n = count << 9;
+      }
+      else
+    #endif
     // no buffering needed if n == 512
     if (n == 512 && block != vol_->cacheBlockNumber()) {
       if (!vol_->readBlock(block, dst)) return -1;
@@ -1044,6 +1056,26 @@ int16_t SdBaseFile::read(void* buf, uint16_t nbyte) {
   return nbyte;
 }
 
+#if USE_MULTI_BLOCK_IO
+
+  /**
+   * Count the blocks from the current position, up to maxBlocks, that lie
+   * in one run of contiguous clusters. curCluster_ is left at the cluster
+   * holding the last of them, ready for read() or write() to carry on from there.
+   */
+  uint16_t SdBaseFile::contiguousBlocks(const uint16_t maxBlocks) {
+    uint16_t count = vol_->blocksPerCluster() - vol_->blockOfCluster(curPosition_);
+    while (count < maxBlocks) {
+      uint32_t next;
+      if (!vol_->fatGet(curCluster_, &next) || next != curCluster_ + 1) break;
+      curCluster_ = next;
+      count += vol_->blocksPerCluster();
+    }
+    return _MIN(count, maxBlocks);
+  }
+
+#endif
+
 /**
  * Read the next entry in a directory.
  *
@@ -1409,6 +1441,55 @@ bool SdBaseFile::seekSet(const uint32_t pos) {
   return true;
 }
 
+#if ENABLED(SD_EXTENT_MAP)
+
+  /**
+   * Walk the file's cluster chain once, recording each run of contiguous
+   * clusters in 'map' so later seeks need no FAT reads.
+   *
+   * \return false if the file has more than 'size' runs, or on a read error.
+   */
+  bool SdBaseFile::mapExtents(extent_t* map, uint8_t &count, const uint8_t size) {
+    count = 0;
+    if (!isFile() || !firstCluster_) return false;
+    uint32_t cluster = firstCluster_, index = 0, next;
+    for (;;) {
+      if (count >= size) { count = 0; return false; }
+      map[count].index = index;
+      map[count].cluster = cluster;
+      count++;
+      // follow the run to its last cluster
+      do {
+        if (!vol_->fatGet(cluster, &next)) { count = 0; return false; }
+        index++;
+      } while (next == ++cluster);
+      if (vol_->isEOC(next)) return true;
+      cluster = next;
+    }
+  }
+
+  /**
+   * Seek with the help of an extent map. Find the run holding the target
+   * with a binary search, then set the position as seekSet() would.
+   */
+  bool SdBaseFile::seekSet(const uint32_t pos, const extent_t* map, const uint8_t count) {
+    if (!isOpen() || pos > fileSize_) return false;
+    if (pos == 0 || !count) return seekSet(pos);
+
+    // seekSet() keeps the cluster holding the byte before the position
+    const uint32_t n = (pos - 1) >> (vol_->clusterSizeShift_ + 9);
+    uint8_t lo = 0, hi = count - 1;
+    while (lo < hi) {
+      const uint8_t mid = (lo + hi + 1) >> 1;
+      if (map[mid].index <= n) lo = mid; else hi = mid - 1;
+    }
+    curCluster_ = map[lo].cluster + (n - map[lo].index);
+    curPosition_ = pos;
+    return true;
+  }
+
+#endif // SD_EXTENT_MAP
+
 void SdBaseFile::setpos(filepos_t* pos) {
   curPosition_ = pos->position;
   curCluster_ = pos->cluster;
@@ -1684,6 +1765,18 @@ int16_t SdBaseFile::write(const void* buf, uint16_t nbyte) {
 
     // block for data write
     uint32_t block = vol_->clusterStartBlock(curCluster_) + blockOfCluster;
+    #if USE_MULTI_BLOCK_IO
+      // write a run of whole blocks in one transfer
+      uint16_t count;
+      if (blockOffset == 0 && nToWrite >= 1024 && (count = contiguousBlocks(nToWrite >> 9)) > 1) {
+        // drop a cached copy of a block in the run
+        const uint32_t cb = vol_->cacheBlockNumber();
+        if (cb >= block && cb < block + count) vol_->cacheSetBlockNumber(0xFFFFFFFF, false);
+        if (!vol_->writeBlocks(block, src, count)) goto FAIL;
+        n = count << 9;
+      }
+      else
+    #endif
     if (n == 512) {
       // full block - don't need to use cache
       if (vol_->cacheBlockNumber() == block) {
@@ -327,6 +327,16 @@ class SdBaseFile {
    */
   bool seekEnd(const int32_t offset = 0) { return seekSet(fileSize_ + offset); }
   bool seekSet(const uint32_t pos);
+
+  #if ENABLED(SD_EXTENT_MAP)
+    /**
+     * A run of contiguous clusters, starting at the file's cluster
+     * 'index' (counted from zero) and the volume's cluster 'cluster'.
+     */
+    typedef struct { uint32_t index, cluster; } extent_t;
+    bool mapExtents(extent_t* map, uint8_t &count, const uint8_t size);
+    bool seekSet(const uint32_t pos, const extent_t* map, const uint8_t count);
+  #endif
   bool sync();
   bool timestamp(SdBaseFile* file);
   bool timestamp(uint8_t flag, uint16_t year, uint8_t month, uint8_t day,
@@ -377,6 +387,9 @@ class SdBaseFile {
   // private functions
   bool addCluster();
   bool addDirCluster();
+  #if USE_MULTI_BLOCK_IO
+    uint16_t contiguousBlocks(const uint16_t maxBlocks);
+  #endif
   dir_t* cacheDirEntry(uint8_t action);
   int8_t lsPrintNext(uint8_t flags, uint8_t indent);
   static bool make83Name(const char* str, uint8_t* name, const char** ptr);
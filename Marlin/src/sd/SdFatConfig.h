@@ -59,6 +59,13 @@
  */
 #define ENDL_CALLS_FLUSH 0
 
+/**
+ * Read runs of contiguous blocks with one multi-block command (CMD18)
+ * if USE_MULTI_BLOCK_IO is nonzero. This saves the command overhead
+ * of every block after the first in sequential file reads.
+ */
+#define USE_MULTI_BLOCK_IO 1
+
 /**
  * Allow FAT12 volumes if FAT12_SUPPORT is nonzero.
  * FAT12 has not been well tested.
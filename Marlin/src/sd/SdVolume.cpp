@@ -142,6 +142,40 @@ bool SdVolume::cacheRawBlock(uint32_t blockNumber, bool dirty) {
   return true;
 }
 
+#if USE_MULTI_BLOCK_IO
+
+  // Read consecutive blocks with a single multi-block transfer
+  bool SdVolume::readBlocks(uint32_t block, uint8_t* dst, uint16_t count) {
+    #if ENABLED(SDIO_SUPPORT)
+      for (; count; --count, dst += 512)
+        if (!sdCard_->readBlock(block++, dst)) return false;
+      return true;
+    #else
+      if (!sdCard_->readStart(block)) return false;
+      bool success = true;
+      for (; success && count; --count, dst += 512)
+        success = sdCard_->readData(dst);
+      return sdCard_->readStop() && success;
+    #endif
+  }
+
+  // Write consecutive blocks with a single multi-block transfer
+  bool SdVolume::writeBlocks(uint32_t block, const uint8_t* src, uint16_t count) {
+    #if ENABLED(SDIO_SUPPORT)
+      for (; count; --count, src += 512)
+        if (!sdCard_->writeBlock(block++, src)) return false;
+      return true;
+    #else
+      if (!sdCard_->writeStart(block, count)) return false;
+      bool success = true;
+      for (; success && count; --count, src += 512)
+        success = sdCard_->writeData(src);
+      return sdCard_->writeStop() && success;
+    #endif
+  }
+
+#endif
+
 // return the size in bytes of a cluster chain
 bool SdVolume::chainSize(uint32_t cluster, uint32_t* size) {
   uint32_t s = 0;
@@ -197,5 +197,11 @@ class SdVolume {
     return  cluster >= FAT32EOC_MIN;
   }
   bool readBlock(uint32_t block, uint8_t* dst) { return sdCard_->readBlock(block, dst); }
+  #if USE_MULTI_BLOCK_IO
+    bool readBlocks(uint32_t block, uint8_t* dst, uint16_t count);
+  #endif
   bool writeBlock(uint32_t block, const uint8_t* dst) { return sdCard_->writeBlock(block, dst); }
+  #if USE_MULTI_BLOCK_IO
+    bool writeBlocks(uint32_t block, const uint8_t* src, uint16_t count);
+  #endif
 };
@@ -30,6 +30,7 @@
 #include "../lcd/ultralcd.h"
 #include "../module/planner.h"        // for synchronize
 #include "../module/printcounter.h"
+#include "../module/temperature.h"
 #include "../core/language.h"
 #include "../gcode/queue.h"
 #include "../module/configuration_store.h"
@@ -113,6 +114,36 @@ char CardReader::proc_filenames[SD_PROCEDURE_DEPTH][MAXPATHNAMELENGTH];
 
 uint32_t CardReader::filesize, CardReader::sdpos;
 
+#if ENABLED(SD_EXTENT_MAP)
+  SdBaseFile::extent_t CardReader::extents[SD_EXTENT_MAP_SIZE];
+  uint8_t CardReader::extent_count; // = 0
+#endif
+
+#if ENABLED(SD_READ_AHEAD)
+  uint8_t CardReader::stream_buf[SD_READ_AHEAD_BLOCKS][512];
+  uint16_t CardReader::stream_len[SD_READ_AHEAD_BLOCKS], CardReader::stream_pos;
+  uint8_t CardReader::stream_head, CardReader::stream_count;
+  uint32_t CardReader::stream_index;
+#endif
+
+#if ENABLED(SD_DIR_INDEX)
+  uint16_t CardReader::dir_index[SD_DIR_INDEX_SIZE], CardReader::dir_count;
+  uint32_t CardReader::dir_cluster;
+  bool CardReader::dir_indexed; // = false
+#endif
+
+#if ENABLED(SD_LINE_INDEX)
+  CardReader::linepos_t CardReader::marks[SD_LINE_INDEX_SIZE], CardReader::frontier;
+  uint8_t CardReader::mark_count; // = 0
+  uint16_t CardReader::mark_stride = 1;
+#endif
+
+#if ENABLED(SD_WRITE_BEHIND)
+  uint8_t CardReader::behind_buf[(SD_WRITE_BEHIND_BLOCKS) * 512];
+  uint16_t CardReader::behind_len; // = 0
+  millis_t CardReader::behind_ms;
+#endif
+
 CardReader::CardReader() {
   #if ENABLED(SDCARD_SORT_ALPHA)
     sort_count = 0;
@@ -190,9 +221,9 @@ int CardReader::countItems(SdFile dir) {
 //
 // Get file/folder info for an item by index
 //
-void CardReader::selectByIndex(SdFile dir, const uint8_t index) {
+void CardReader::selectByIndex(SdFile dir, const uint16_t index) {
   dir_t p;
-  for (uint8_t cnt = 0; dir.readDir(&p, longFilename) > 0;) {
+  for (uint16_t cnt = 0; dir.readDir(&p, longFilename) > 0;) {
     if (is_dir_or_gcode(p)) {
       if (cnt == index) {
         createFilename(filename, p);
@@ -355,6 +386,9 @@ void CardReader::printFilename() {
 
 void CardReader::mount() {
   flag.mounted = false;
+  #if ENABLED(SD_DIR_INDEX)
+    dir_indexed = false;
+  #endif
   if (root.isOpen()) root.close();
 
   if (!sd2card.init(SPI_SPEED, SDSS)
@@ -512,6 +546,15 @@ void CardReader::openFileRead(char * const path, const uint8_t subcall_type/*=0*
   if (file.open(curDir, fname, O_READ)) {
     filesize = file.fileSize();
     sdpos = 0;
+    #if ENABLED(SD_EXTENT_MAP)
+      file.mapExtents(extents, extent_count, SD_EXTENT_MAP_SIZE);
+    #endif
+    #if ENABLED(SD_READ_AHEAD)
+      reset_stream(0);
+    #endif
+    #if ENABLED(SD_LINE_INDEX)
+      reset_line_index();
+    #endif
 
     PORT_REDIRECT(SERIAL_BOTH);
     SERIAL_ECHOLNPAIR(STR_SD_FILE_OPENED, fname, STR_SD_SIZE, filesize);
@@ -546,6 +589,19 @@ void CardReader::openFileWrite(char * const path) {
 
   if (file.open(curDir, fname, O_CREAT | O_APPEND | O_WRITE | O_TRUNC)) {
     flag.saving = true;
+    #if ENABLED(SD_EXTENT_MAP)
+      extent_count = 0;             // The file is growing
+    #endif
+    #if ENABLED(SD_LINE_INDEX)
+      reset_line_index();
+    #endif
+    #if ENABLED(SD_WRITE_BEHIND)
+      behind_len = 0;
+      behind_ms = 0;
+    #endif
+    #if ENABLED(SD_DIR_INDEX)
+      dir_indexed = false;          // The file may be new
+    #endif
     selectFileByName(fname);
     #if ENABLED(EMERGENCY_PARSER)
       emergency_parser.disable();
@@ -572,6 +628,9 @@ void CardReader::removeFile(const char * const name) {
   if (file.remove(curDir, fname)) {
     SERIAL_ECHOLNPAIR("File deleted:", fname);
     sdpos = 0;
+    #if ENABLED(SD_DIR_INDEX)
+      dir_indexed = false;
+    #endif
     #if ENABLED(SDCARD_SORT_ALPHA)
       presort();
     #endif
@@ -604,7 +663,7 @@ void CardReader::write_command(char * const buf) {
   end[1] = '\r';
   end[2] = '\n';
   end[3] = '\0';
-  file.write(begin);
+  write(begin, strlen(begin));
 
   if (file.writeError) SERIAL_ERROR_MSG(STR_SD_ERR_WRITE_TO_FILE);
 }
@@ -652,6 +711,10 @@ void CardReader::beginautostart() {
 }
 
 void CardReader::closefile(const bool store_location) {
+  #if ENABLED(SD_WRITE_BEHIND)
+    if (!flush_behind(true)) SERIAL_ERROR_MSG(STR_SD_ERR_WRITE_TO_FILE);
+    behind_ms = 0;
+  #endif
   file.sync();
   file.close();
   flag.saving = flag.logging = false;
@@ -678,6 +741,15 @@ void CardReader::selectFileByIndex(const uint16_t nr) {
       return;
     }
   #endif
+  #if ENABLED(SD_DIR_INDEX)
+    index_work_dir();
+    if (nr < dir_count) {
+      const uint16_t i = _MIN(nr, uint16_t(SD_DIR_INDEX_SIZE - 1));
+      workDir.seekSet(uint32_t(dir_index[i]) << 5);
+      selectByIndex(workDir, nr - i);
+      return;
+    }
+  #endif
   workDir.rewind();
   selectByIndex(workDir, nr);
 }
@@ -700,10 +772,45 @@ void CardReader::selectFileByName(const char * const match) {
 }
 
 uint16_t CardReader::countFilesInWorkDir() {
-  workDir.rewind();
-  return countItems(workDir);
+  #if ENABLED(SD_DIR_INDEX)
+    index_work_dir();
+    #if ENABLED(SDCARD_SORT_ALPHA) && SDSORT_USES_RAM && SDSORT_CACHE_NAMES
+      nrFiles = dir_count;
+    #endif
+    return dir_count;
+  #else
+    workDir.rewind();
+    return countItems(workDir);
+  #endif
 }
 
+#if ENABLED(SD_DIR_INDEX)
+
+  /**
+   * Find the items in the working directory with one pass over its
+   * entries, keeping the position where the read for each one starts.
+   * Entries never move, so the index holds until the directory changes
+   * or an item is created or removed.
+   */
+  void CardReader::index_work_dir() {
+    if (dir_indexed && dir_cluster == workDir.firstCluster()) return;
+    dir_t p;
+    dir_count = 0;
+    workDir.rewind();
+    for (;;) {
+      const uint16_t pos = workDir.curPosition() >> 5;
+      if (workDir.readDir(&p, longFilename) <= 0) break;
+      if (is_dir_or_gcode(p)) {
+        if (dir_count < SD_DIR_INDEX_SIZE) dir_index[dir_count] = pos;
+        dir_count++;
+      }
+    }
+    dir_cluster = workDir.firstCluster();
+    dir_indexed = true;
+  }
+
+#endif
+
 /**
  * Dive to the given DOS 8.3 file path, with optional echo of the dive paths.
  *
@@ -1069,6 +1176,254 @@ uint16_t CardReader::get_num_Files() {
   ;
 }
 
+#if ENABLED(SD_READ_AHEAD)
+
+  /**
+   * Read into the free buffers that follow the last full one, up to the
+   * end of the ring, in a single read. After a seek the first read only
+   * goes to the end of the block, so later ones stay block aligned and
+   * SdBaseFile reads them straight into the buffers, bypassing the volume
+   * cache, with one multi-block transfer for each contiguous run.
+   */
+  bool CardReader::fill_stream() {
+    if (stream_count >= SD_READ_AHEAD_BLOCKS) return false;
+    uint8_t slot = (stream_head + stream_count) % (SD_READ_AHEAD_BLOCKS);
+    const uint16_t offset = file.curPosition() & 0x1FF;
+    const uint8_t free = _MIN(SD_READ_AHEAD_BLOCKS - stream_count, SD_READ_AHEAD_BLOCKS - slot);
+    int16_t n = file.read(stream_buf[slot], offset ? 512 - offset : 512U * free);
+    if (n <= 0) return false;
+    for (; n > 0; n -= 512, ++slot) {
+      stream_len[slot] = _MIN(n, 512);
+      stream_count++;
+    }
+    return true;
+  }
+
+  // Get the next byte of the printing file, or -1 at the end
+  int16_t CardReader::get() {
+    sdpos = stream_index;
+    if (!stream_count && !fill_stream()) return -1;
+    const uint8_t c = stream_buf[stream_head][stream_pos];
+    stream_index++;
+    if (++stream_pos >= stream_len[stream_head]) {
+      stream_pos = 0;
+      if (++stream_head >= SD_READ_AHEAD_BLOCKS) stream_head = 0;
+      stream_count--;
+    }
+    return c;
+  }
+
+  // Point to the unread part of the current block, reading more if needed.
+  // Return its size, or 0 at the end, with sdpos at the end of the file.
+  uint16_t CardReader::peek(const char* &data) {
+    if (!stream_count && !fill_stream()) { sdpos = stream_index; return 0; }
+    data = (const char*)&stream_buf[stream_head][stream_pos];
+    return stream_len[stream_head] - stream_pos;
+  }
+
+  // Consume 'n' bytes of the peek() data, leaving sdpos on the last one like get()
+  void CardReader::skip(const uint16_t n) {
+    stream_index += n;
+    sdpos = stream_index - 1;
+    if ((stream_pos += n) >= stream_len[stream_head]) {
+      stream_pos = 0;
+      if (++stream_head >= SD_READ_AHEAD_BLOCKS) stream_head = 0;
+      stream_count--;
+    }
+  }
+
+  // Fetch blocks while there's nothing else to do with the file,
+  // waiting for half the ring to be free so they come in runs
+  void CardReader::read_ahead() {
+    if (isFileOpen() && flag.sdprinting && stream_count <= (SD_READ_AHEAD_BLOCKS) / 2) fill_stream();
+  }
+
+#endif // SD_READ_AHEAD
+
+#if ENABLED(SD_LINE_INDEX)
+
+  static bool is_layer_comment(const char * const head, const uint8_t len) {
+    return (len >= 7 && !strncmp_P(head, PSTR(";LAYER:"), 7))
+        || (len >= 13 && !strncmp_P(head, PSTR(";LAYER_CHANGE"), 13));
+  }
+
+  // Index the start of every mark_stride'th layer. When the index is full
+  // keep every other mark, and mark half as often from then on.
+  void CardReader::add_layer_mark(const linepos_t &m) {
+    if (m.layer != uint32_t(mark_count) * mark_stride) return;
+    if (mark_count >= SD_LINE_INDEX_SIZE) {
+      for (uint8_t i = 0; i < mark_count; i += 2) marks[i / 2] = marks[i];
+      mark_count = (mark_count + 1) / 2;
+      mark_stride *= 2;
+      if (m.layer != uint32_t(mark_count) * mark_stride) return;
+    }
+    marks[mark_count++] = m;
+  }
+
+  /**
+   * Read the open file a line at a time from 'm', which is at the start of
+   * a line, until 'm' is at the start of the line that holds stop.pos, is
+   * line stop.line (from 0), or begins layer stop.layer. A copy of the file
+   * does the reading, so the print position stays put. Return false if the
+   * end of the file comes first, with 'm' at the last line.
+   */
+  bool CardReader::scan_lines(linepos_t &m, const linepos_t &stop) {
+    SdBaseFile f = file;
+    #if ENABLED(SD_EXTENT_MAP)
+      if (!f.seekSet(m.pos, extents, extent_count)) return false;
+    #else
+      if (!f.seekSet(m.pos)) return false;
+    #endif
+    if (m.line >= stop.line) return true;
+
+    uint8_t buf[64];
+    char head[13];                  // Enough of the line to tell a layer comment
+    uint8_t hlen = 0;
+    bool checked = false, layer_line = false;
+    uint32_t pos = m.pos;
+    for (int16_t n; (n = f.read(buf, sizeof(buf))) > 0;) {
+      thermalManager.manage_heater();   // Long files take a while. Keep heaters and watchdog going.
+      for (int16_t i = 0; i < n; i++, pos++) {
+        const char c = buf[i];
+        if (!checked) {
+          if (c != '\n') head[hlen++] = c;
+          if (c == '\n' || hlen == sizeof(head)) {
+            checked = true;
+            layer_line = is_layer_comment(head, hlen);
+            if (layer_line) {
+              if (m.layer >= stop.layer) return true;
+              add_layer_mark(m);
+            }
+          }
+        }
+        if (c == '\n') {
+          if (pos >= stop.pos) return true;
+          m.pos = pos + 1;
+          m.line++;
+          m.layer += layer_line;
+          if (m.line >= stop.line) return true;
+          hlen = 0;
+          checked = layer_line = false;
+        }
+      }
+    }
+    return false;
+  }
+
+  /**
+   * Find a line start in the open file, going by 'stop' as for scan_lines.
+   * The scan begins at the nearest known line start before the stop: the
+   * furthest point scanned so far, or else the last layer mark before it.
+   */
+  bool CardReader::findLine(linepos_t &m, const linepos_t &stop) {
+    #define BEFORE_STOP(P) ((P).pos <= stop.pos && (P).line <= stop.line && (P).layer <= stop.layer)
+    if (BEFORE_STOP(frontier))
+      m = frontier;
+    else {
+      uint8_t lo = 0, hi = mark_count;
+      while (lo < hi) {
+        const uint8_t mid = (lo + hi) / 2;
+        if (BEFORE_STOP(marks[mid])) lo = mid + 1; else hi = mid;
+      }
+      if (lo) m = marks[lo - 1]; else m = { 0, 0, 0 };
+    }
+    const bool found = scan_lines(m, stop);
+    if (m.pos > frontier.pos) frontier = m;
+    return found;
+  }
+
+  // Set the file position to a line, counting from 1
+  bool CardReader::seekLine(const uint32_t line) {
+    linepos_t m;
+    const linepos_t stop = { UINT32_MAX, line ? line - 1 : 0, UINT32_MAX };
+    if (!findLine(m, stop)) return false;
+    setIndex(m.pos);
+    return true;
+  }
+
+  // Set the file position to the start of a layer
+  bool CardReader::seekLayer(const uint32_t layer) {
+    linepos_t m;
+    const linepos_t stop = { UINT32_MAX, UINT32_MAX, layer };
+    if (!findLine(m, stop)) return false;
+    setIndex(m.pos);
+    return true;
+  }
+
+  // Report the line and layer of the current file position
+  void CardReader::report_line() {
+    linepos_t m, next;
+    const linepos_t stop = { sdpos, UINT32_MAX, UINT32_MAX };
+    findLine(m, stop);
+    // The layers before the next line include one started on this line
+    const linepos_t stop_next = { UINT32_MAX, m.line + 1, UINT32_MAX };
+    findLine(next, stop_next);
+    SERIAL_ECHOPAIR(STR_SD_LINE, m.line + 1);
+    if (next.layer) SERIAL_ECHOPAIR(STR_SD_LAYER, next.layer - 1);
+    SERIAL_EOL();
+  }
+
+#endif // SD_LINE_INDEX
+
+#if ENABLED(SD_WRITE_BEHIND)
+
+  /**
+   * Write the held data out to the file. Unless 'all' is set only whole
+   * blocks are written, with any bytes up to the next block boundary
+   * first, so the rest go straight from the buffer to the card in one
+   * multi-block transfer. Whatever is left moves to the front.
+   */
+  bool CardReader::flush_behind(const bool all) {
+    uint16_t n = behind_len;
+    if (!all) {
+      const uint16_t head = -file.curPosition() & 0x1FF;
+      n = n < head ? 0 : n - ((n - head) & 0x1FF);
+    }
+    if (!n) return true;
+    const bool ok = file.write(behind_buf, n) == int16_t(n);
+    behind_len -= n;
+    memmove(behind_buf, behind_buf + n, behind_len);
+    return ok;
+  }
+
+  // Hold data for the file being written, writing blocks only when full
+  int16_t CardReader::write(void* buf, uint16_t nbyte) {
+    if (!file.isOpen()) return -1;
+    const uint8_t *src = (uint8_t*)buf;
+    for (uint16_t left = nbyte; left;) {
+      if (behind_len == sizeof(behind_buf) && !flush_behind(false)) return -1;
+      const uint16_t n = _MIN(left, sizeof(behind_buf) - behind_len);
+      memcpy(behind_buf + behind_len, src, n);
+      behind_len += n;
+      src += n;
+      left -= n;
+    }
+    if (!behind_ms) behind_ms = millis() + SD_WRITE_BEHIND_MS;
+    return nbyte;
+  }
+
+  /**
+   * Called from idle(). Writes whole blocks once half the buffer is full.
+   * So a power loss costs no more than SD_WRITE_BEHIND_MS of data, once
+   * that long has passed since the first unsynced write everything held
+   * is written out and the directory entry synced.
+   */
+  void CardReader::write_behind() {
+    if (!behind_ms || !isFileOpen()) return;
+    bool ok;
+    if (ELAPSED(millis(), behind_ms)) {
+      ok = flush_behind(true) && file.sync();
+      behind_ms = 0;
+    }
+    else if (behind_len >= 512 * ((SD_WRITE_BEHIND_BLOCKS + 1) / 2))
+      ok = flush_behind(false);
+    else
+      return;
+    if (!ok) SERIAL_ERROR_MSG(STR_SD_ERR_WRITE_TO_FILE);
+  }
+
+#endif // SD_WRITE_BEHIND
+
 //
 // Return from procedure or close out the Print Job
 //
@@ -1102,8 +1457,11 @@ void CardReader::fileHasFinished() {
   void CardReader::auto_report_sd_status() {
     millis_t current_ms = millis();
     if (auto_report_sd_interval && ELAPSED(current_ms, next_sd_report_ms)) {
-      next_sd_report_ms = current_ms + 1000UL * auto_report_sd_interval;
       PORT_REDIRECT(auto_report_port);
+      #if SERIAL_TX_BATCH
+        if (!serial_tx_room(32)) return;
+      #endif
+      next_sd_report_ms = current_ms + 1000UL * auto_report_sd_interval;
       report_status();
     }
   }
@@ -1140,6 +1498,44 @@ void CardReader::fileHasFinished() {
     }
   }
 
+  #if ENABLED(POWER_LOSS_JOURNAL)
+
+    /**
+     * Get the first block of the job recovery journal, a contiguous file of
+     * POWER_LOSS_JOURNAL_BLOCKS blocks, so records can be written in place.
+     * A journal already on the card is kept for a resumed job to carry on.
+     * A new one is zeroed, so nothing left in its clusters reads as a record.
+     */
+    bool CardReader::openJobRecoveryJournal(uint32_t &block) {
+      if (!isMounted() || recovery.file.isOpen()) return false;
+      constexpr uint32_t size = (POWER_LOSS_JOURNAL_BLOCKS) * 512UL;
+      uint32_t last;
+      if (recovery.file.open(&root, recovery.filename, O_READ)) {
+        const bool ok = recovery.file.fileSize() == size && recovery.file.contiguousRange(&block, &last);
+        recovery.file.close();
+        if (ok) return true;
+        if (!SdBaseFile::remove(&root, recovery.filename)) return false;
+      }
+      if (!recovery.file.createContiguous(&root, recovery.filename, size)) return false;
+      const bool ok = recovery.file.contiguousRange(&block, &last);
+      recovery.file.close();
+      if (!ok) return false;
+      LOOP_L_N(i, POWER_LOSS_JOURNAL_BLOCKS)
+        if (!writeJobRecoveryBlock(block + i, nullptr, 0)) return false;
+      return true;
+    }
+
+    // Write data to a block, zero-filled, through the volume cache
+    bool CardReader::writeJobRecoveryBlock(const uint32_t block, const void * const data, const uint16_t size) {
+      cache_t * const cache = volume.cacheClear();
+      if (!cache) return false;
+      if (size) memcpy(cache->data, data, size);
+      memset(cache->data + size, 0, 512 - size);
+      return sd2card.writeBlock(block, cache->data);
+    }
+
+  #endif // POWER_LOSS_JOURNAL
+
 #endif // POWER_LOSS_RECOVERY
 
 #endif // SDSUPPORT
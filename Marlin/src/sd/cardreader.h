@@ -143,16 +143,46 @@ public:
     static bool jobRecoverFileExists();
     static void openJobRecoveryFile(const bool read);
     static void removeJobRecoveryFile();
+    #if ENABLED(POWER_LOSS_JOURNAL)
+      static bool openJobRecoveryJournal(uint32_t &block);
+      static bool writeJobRecoveryBlock(const uint32_t block, const void * const data, const uint16_t size);
+    #endif
   #endif
 
   static inline bool isFileOpen() { return isMounted() && file.isOpen(); }
   static inline uint32_t getIndex() { return sdpos; }
+  static inline uint32_t getFileSize() { return filesize; }
   static inline bool eof() { return sdpos >= filesize; }
-  static inline void setIndex(const uint32_t index) { sdpos = index; file.seekSet(index); }
   static inline char* getWorkDirName() { workDir.getDosName(filename); return filename; }
-  static inline int16_t get() { sdpos = file.curPosition(); return (int16_t)file.read(); }
+  #if ENABLED(SD_EXTENT_MAP)
+    static inline bool seekFile(const uint32_t index) { return file.seekSet(index, extents, extent_count); }
+  #else
+    static inline bool seekFile(const uint32_t index) { return file.seekSet(index); }
+  #endif
+  #if ENABLED(SD_READ_AHEAD)
+    static inline void setIndex(const uint32_t index) { sdpos = index; seekFile(index); reset_stream(index); }
+    static int16_t get();
+    static uint16_t peek(const char* &data);
+    static void skip(const uint16_t n);
+    static void read_ahead();
+  #else
+    static inline void setIndex(const uint32_t index) { sdpos = index; seekFile(index); }
+    static inline int16_t get() { sdpos = file.curPosition(); return (int16_t)file.read(); }
+  #endif
+  #if ENABLED(SD_LINE_INDEX)
+    typedef struct { uint32_t pos, line, layer; } linepos_t; // A line start, with the lines and layers before it
+    static bool findLine(linepos_t &m, const linepos_t &stop);
+    static bool seekLine(const uint32_t line);
+    static bool seekLayer(const uint32_t layer);
+    static void report_line();
+  #endif
   static inline int16_t read(void* buf, uint16_t nbyte) { return file.isOpen() ? file.read(buf, nbyte) : -1; }
-  static inline int16_t write(void* buf, uint16_t nbyte) { return file.isOpen() ? file.write(buf, nbyte) : -1; }
+  #if ENABLED(SD_WRITE_BEHIND)
+    static int16_t write(void* buf, uint16_t nbyte);
+    static void write_behind();
+  #else
+    static inline int16_t write(void* buf, uint16_t nbyte) { return file.isOpen() ? file.write(buf, nbyte) : -1; }
+  #endif
 
   static Sd2Card& getSd2Card() { return sd2card; }
 
@@ -237,6 +267,59 @@ private:
 
   static uint32_t filesize, sdpos;
 
+  //
+  // Cluster runs of the printing file, for seeks without FAT reads
+  //
+  #if ENABLED(SD_EXTENT_MAP)
+    static SdBaseFile::extent_t extents[SD_EXTENT_MAP_SIZE];
+    static uint8_t extent_count;    // Zero if the file has too many runs
+  #endif
+
+  //
+  // Blocks of the printing file read ahead of get()
+  //
+  #if ENABLED(SD_READ_AHEAD)
+    static uint8_t stream_buf[SD_READ_AHEAD_BLOCKS][512];
+    static uint16_t stream_len[SD_READ_AHEAD_BLOCKS], stream_pos;
+    static uint8_t stream_head, stream_count;
+    static uint32_t stream_index;   // File position of the next byte for get()
+    static inline void reset_stream(const uint32_t index) { stream_count = stream_pos = 0; stream_index = index; }
+    static bool fill_stream();
+  #endif
+
+  //
+  // Data for the file being written, held until it fills whole blocks
+  //
+  #if ENABLED(SD_WRITE_BEHIND)
+    static uint8_t behind_buf[(SD_WRITE_BEHIND_BLOCKS) * 512];
+    static uint16_t behind_len;
+    static millis_t behind_ms;      // Time to write out and sync held data, or 0
+    static bool flush_behind(const bool all);
+  #endif
+
+  //
+  // Entry positions of the working directory's items
+  //
+  #if ENABLED(SD_DIR_INDEX)
+    static uint16_t dir_index[SD_DIR_INDEX_SIZE];
+    static uint16_t dir_count;      // Items in the indexed directory
+    static uint32_t dir_cluster;    // First cluster of the indexed directory
+    static bool dir_indexed;
+    static void index_work_dir();
+  #endif
+
+  //
+  // Layer starts of the open file, as far as it has been scanned
+  //
+  #if ENABLED(SD_LINE_INDEX)
+    static linepos_t marks[SD_LINE_INDEX_SIZE], frontier;
+    static uint8_t mark_count;
+    static uint16_t mark_stride;    // Layers from one mark to the next
+    static inline void reset_line_index() { mark_count = 0; mark_stride = 1; frontier = { 0, 0, 0 }; }
+    static void add_layer_mark(const linepos_t &m);
+    static bool scan_lines(linepos_t &m, const linepos_t &stop);
+  #endif
+
   //
   // Procedure calls to other files
   //
@@ -263,7 +346,7 @@ private:
   //
   static bool is_dir_or_gcode(const dir_t &p);
   static int countItems(SdFile dir);
-  static void selectByIndex(SdFile dir, const uint8_t index);
+  static void selectByIndex(SdFile dir, const uint16_t index);
   static void selectByName(SdFile dir, const char * const match);
   static void printListing(SdFile parent, const char * const prepend=nullptr);
 
@@ -62,7 +62,7 @@ class Sd2Card {
     inline bool readStop() const                                 { return true; }
 
     inline bool writeStart(const uint32_t block, const uint32_t) { pos = block; return ready(); }
-    inline bool writeData(uint8_t* src)                          { return writeBlock(pos++, src); }
+    inline bool writeData(const uint8_t* src)                    { return writeBlock(pos++, src); }
     inline bool writeStop() const                                { return true; }
 
     bool readBlock(uint32_t block, uint8_t* dst);